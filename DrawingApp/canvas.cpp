@@ -0,0 +1,95 @@
+#include "canvas.h"
+#include <cmath>
+#include <algorithm>
+
+Canvas::Canvas(const QSize& size, QRgb background)
+    : img(size, QImage::Format_RGB32)
+{
+    fill(background);
+}
+
+inline void Canvas::plot(int x, int y, QRgb color)
+{
+    if (uint(x) >= uint(img.width()) || uint(y) >= uint(img.height())) return;
+    reinterpret_cast<QRgb*>(img.scanLine(y))[x] = color;
+}
+
+void Canvas::fill(QRgb color)
+{
+    img.fill(color);
+    markDirty(img.rect());
+}
+
+void Canvas::setPixel(int x, int y, QRgb color)
+{
+    plot(x, y, color);
+    markDirty(QRect(x, y, 1, 1));
+}
+
+void Canvas::drawLineBresenham(const QPoint& p1, const QPoint& p2, QRgb color)
+{
+    int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
+    int dx = std::abs(x2 - x1), dy = std::abs(y2 - y1);
+    int sx = (x1 < x2) ? 1 : -1;
+    int sy = (y1 < y2) ? 1 : -1;
+    int err = dx - dy;
+
+    markDirty(QRect(p1, p2).normalized());
+    while (true) {
+        plot(x1, y1, color);
+        if (x1 == x2 && y1 == y2) break;
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x1 += sx; }
+        if (e2 < dx) { err += dx; y1 += sy; }
+    }
+}
+
+void Canvas::drawLineDDA(const QPoint& p1, const QPoint& p2, QRgb color)
+{
+    int dx = p2.x() - p1.x();
+    int dy = p2.y() - p1.y();
+    int steps = std::max(std::abs(dx), std::abs(dy));
+
+    markDirty(QRect(p1, p2).normalized());
+    if (steps == 0) {
+        plot(p1.x(), p1.y(), color);
+        return;
+    }
+
+    double xInc = dx / double(steps);
+    double yInc = dy / double(steps);
+    double x = p1.x(), y = p1.y();
+    for (int i = 0; i <= steps; ++i) {
+        plot(qRound(x), qRound(y), color);
+        x += xInc;
+        y += yInc;
+    }
+}
+
+void Canvas::drawCircleMidpoint(const QPoint& c, int r, QRgb color)
+{
+    if (r < 0) return;
+
+    markDirty(QRect(c.x() - r, c.y() - r, 2 * r + 1, 2 * r + 1));
+    int x = 0, y = r, p = 1 - r;
+    while (x <= y) {
+        plot(c.x() + x, c.y() + y, color);
+        plot(c.x() - x, c.y() + y, color);
+        plot(c.x() + x, c.y() - y, color);
+        plot(c.x() - x, c.y() - y, color);
+        plot(c.x() + y, c.y() + x, color);
+        plot(c.x() - y, c.y() + x, color);
+        plot(c.x() + y, c.y() - x, color);
+        plot(c.x() - y, c.y() - x, color);
+        ++x;
+        if (p < 0) p += 2 * x + 1;
+        else { --y; p += 2 * (x - y) + 1; }
+    }
+}
+
+QRect Canvas::takeDirty()
+{
+    QRect r = dirty;
+    dirty = QRect();
+    return r;
+}
@@ -0,0 +1,37 @@
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+// Persistent drawing surface. Rasterisers write straight into the image's scanlines and
+// record the rectangle they touched, so the widget only has to repaint that part.
+class Canvas
+{
+public:
+    Canvas() = default;
+    explicit Canvas(const QSize& size, QRgb background = qRgb(0, 0, 0));
+
+    const QImage& image() const { return img; }
+    QRect rect() const { return img.rect(); }
+
+    void fill(QRgb color);
+    void setPixel(int x, int y, QRgb color);
+    void drawLineBresenham(const QPoint& p1, const QPoint& p2, QRgb color);
+    void drawLineDDA(const QPoint& p1, const QPoint& p2, QRgb color);
+    void drawCircleMidpoint(const QPoint& c, int r, QRgb color);
+
+    // Region written since the last call; resets it.
+    QRect takeDirty();
+
+private:
+    inline void plot(int x, int y, QRgb color);
+    void markDirty(const QRect& r) { dirty |= (r & img.rect()); }
+
+    QImage img;
+    QRect dirty;
+};
+
+#endif // CANVAS_H
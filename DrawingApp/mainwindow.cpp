@@ -1,24 +1,29 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "my_label.h"
-#include <QPixmap>
-#include <QImage>
-#include <QPainter>
 #include <QDebug>
+#include <cmath>
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::MainWindow)
+    ui(new Ui::MainWindow),
+    stroke(&canvas)
 {
     ui->setupUi(this);
     lastPoint1 = QPoint(-1, -1);
     lastPoint2 = QPoint(-1, -1);
-    QPixmap pix(ui->frame->width(), ui->frame->height());
-    pix.fill(Qt::black);
-    ui->frame->setPixmap(pix);
+    canvas = Canvas(ui->frame->size(), qRgb(0, 0, 0));
+    ui->frame->setCanvas(&canvas.image());
 
     connect(ui->frame, SIGNAL(Mouse_Pos()), this, SLOT(Mouse_Pressed()));
     connect(ui->frame, SIGNAL(sendMousePosition(QPoint&)), this, SLOT(showMousePosition(QPoint&)));
+    connect(ui->frame, &my_label::strokeStarted, this, &MainWindow::onStrokeStarted);
+    connect(ui->frame, &my_label::strokeMoved, this, &MainWindow::onStrokeMoved);
+    connect(ui->frame, &my_label::strokeFinished, this, &MainWindow::onStrokeFinished);
+
+    frameTimer.setSingleShot(true);
+    frameTimer.setInterval(16);
+    connect(&frameTimer, &QTimer::timeout, this, &MainWindow::renderFrame);
 }
 
 MainWindow::~MainWindow()
@@ -30,7 +35,9 @@ void MainWindow::showMousePosition(QPoint &pos)
 {
     sc_x = pos.x();
     sc_y = pos.y();
-    ui->mouse_movement->setText("X : " + QString::number(sc_x) + ", Y : " + QString::number(sc_y));
+    // the label text is refreshed with the next frame, not on every move
+    positionChanged = true;
+    scheduleFrame();
 }
 
 void MainWindow::Mouse_Pressed()
@@ -46,10 +53,6 @@ void MainWindow::Mouse_Pressed()
 
 void MainWindow::addPoint(int x, int y, int c)
 {
-    QPixmap pm = ui->frame->pixmap();
-    if (pm.isNull()) return;
-    QImage img = pm.toImage();
-
     int r = 0, g = 0, b = 0;
     switch (c) {
     case 0: r = g = b = 255; break;
@@ -58,26 +61,84 @@ void MainWindow::addPoint(int x, int y, int c)
     case 3: b = 255; break;
     }
 
-    img.setPixel(x, y, qRgb(r, g, b));
-    ui->frame->setPixmap(QPixmap::fromImage(img));
+    canvas.setPixel(x, y, qRgb(r, g, b));
+    flushCanvas();
+}
+
+// Repaint only the part of the label the last operations touched.
+void MainWindow::flushCanvas()
+{
+    const QRect dirty = canvas.takeDirty();
+    if (!dirty.isEmpty())
+        ui->frame->update(dirty);
+}
+
+void MainWindow::scheduleFrame()
+{
+    if (!frameTimer.isActive())
+        frameTimer.start();
+}
+
+void MainWindow::renderFrame()
+{
+    stroke.rasterisePending();
+    flushCanvas();
+
+    if (positionChanged) {
+        ui->mouse_movement->setText("X : " + QString::number(sc_x) + ", Y : " + QString::number(sc_y));
+        positionChanged = false;
+    }
+}
+
+void MainWindow::onStrokeStarted(QPoint pos)
+{
+    stroke.begin(pos);
+    scheduleFrame();
+}
+
+void MainWindow::onStrokeMoved(QPoint pos)
+{
+    stroke.addSample(pos);
+    scheduleFrame();
+}
+
+void MainWindow::onStrokeFinished()
+{
+    stroke.end();
+    scheduleFrame();
 }
 
 void MainWindow::on_clear_clicked()
 {
     lastPoint1 = lastPoint2 = QPoint(-1, -1);
-    QPixmap pix(ui->frame->width(), ui->frame->height());
-    pix.fill(Qt::black);
-    ui->frame->setPixmap(pix);
+    stroke.rasterisePending();
+    canvas.fill(qRgb(0, 0, 0));
+    flushCanvas();
 }
 
 void MainWindow::on_draw_line_clicked()
 {
     if (lastPoint1 == QPoint(-1, -1) || lastPoint2 == QPoint(-1, -1)) return;
 
-    QPixmap pm = ui->frame->pixmap();
-    QPainter painter(&pm);
-    painter.setPen(QPen(Qt::blue, 2));
-    painter.drawLine(lastPoint1, lastPoint2);
-    painter.end();
-    ui->frame->setPixmap(pm);
+    canvas.drawLineBresenham(lastPoint1, lastPoint2, qRgb(0, 0, 255));
+    flushCanvas();
+}
+
+void MainWindow::on_draw_line_dda_clicked()
+{
+    if (lastPoint1 == QPoint(-1, -1) || lastPoint2 == QPoint(-1, -1)) return;
+
+    canvas.drawLineDDA(lastPoint1, lastPoint2, qRgb(0, 255, 0));
+    flushCanvas();
+}
+
+void MainWindow::on_draw_circle_clicked()
+{
+    if (lastPoint1 == QPoint(-1, -1) || lastPoint2 == QPoint(-1, -1)) return;
+
+    // centre at the older point, through the newer one
+    QPoint d = lastPoint2 - lastPoint1;
+    int r = qRound(std::sqrt(double(d.x()) * d.x() + double(d.y()) * d.y()));
+    canvas.drawCircleMidpoint(lastPoint1, r, qRgb(255, 255, 0));
+    flushCanvas();
 }
@@ -4,6 +4,9 @@
 #include <QMainWindow>
 #include <QPoint>
 #include "my_label.h"
+#include "canvas.h"
+#include "stroke_engine.h"
+#include <QTimer>
 
 namespace Ui {
 class MainWindow;
@@ -22,10 +25,25 @@ private slots:
     void showMousePosition(QPoint &pos);
     void on_clear_clicked();
     void on_draw_line_clicked();
+    void on_draw_line_dda_clicked();
+    void on_draw_circle_clicked();
+    void onStrokeStarted(QPoint pos);
+    void onStrokeMoved(QPoint pos);
+    void onStrokeFinished();
+    void renderFrame();
 
 private:
     Ui::MainWindow *ui;
     void addPoint(int x, int y, int c = 1);
+    void flushCanvas();
+    void scheduleFrame();
+
+    Canvas canvas;
+    StrokeEngine stroke;
+
+    // mouse input is coalesced and drawn once per frame
+    QTimer frameTimer;
+    bool positionChanged = false;
 
     QPoint lastPoint1;
     QPoint lastPoint2;
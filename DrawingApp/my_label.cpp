@@ -1,4 +1,6 @@
 #include "my_label.h"
+#include <QPainter>
+#include <QPaintEvent>
 
 my_label::my_label(QWidget *parent) : QLabel(parent)
 {
@@ -11,6 +13,8 @@ void my_label::mouseMoveEvent(QMouseEvent *ev)
     if (pos.x() >= 0 && pos.y() >= 0 && pos.x() < this->width() && pos.y() < this->height()) {
         emit sendMousePosition(pos);
     }
+    if (ev->buttons() & Qt::LeftButton)
+        emit strokeMoved(pos);
 }
 
 void my_label::mousePressEvent(QMouseEvent *ev)
@@ -20,5 +24,31 @@ void my_label::mousePressEvent(QMouseEvent *ev)
         x = pt.x();
         y = pt.y();
         emit Mouse_Pos();
+        emit strokeStarted(pt.toPoint());
     }
 }
+
+void my_label::mouseReleaseEvent(QMouseEvent *ev)
+{
+    if (ev->button() == Qt::LeftButton)
+        emit strokeFinished();
+}
+
+void my_label::setCanvas(const QImage *image)
+{
+    canvas = image;
+    update();
+}
+
+void my_label::paintEvent(QPaintEvent *ev)
+{
+    if (!canvas) {
+        QLabel::paintEvent(ev);
+        return;
+    }
+
+    // blit only the exposed part of the backing image
+    QPainter painter(this);
+    const QRect r = ev->rect() & canvas->rect();
+    painter.drawImage(r.topLeft(), *canvas, r);
+}
@@ -2,6 +2,7 @@
 #define MY_LABEL_H
 #include <QLabel>
 #include <QMouseEvent>
+#include <QImage>
 
 class my_label : public QLabel
 {
@@ -10,13 +11,23 @@ public:
     explicit my_label(QWidget *parent = nullptr);
     int x, y;
 
+    void setCanvas(const QImage *image);
+
 protected:
     void mouseMoveEvent(QMouseEvent *ev);
     void mousePressEvent(QMouseEvent *ev);
+    void mouseReleaseEvent(QMouseEvent *ev);
+    void paintEvent(QPaintEvent *ev) override;
+
+private:
+    const QImage *canvas = nullptr;
 
 signals:
     void sendMousePosition(QPoint&);
     void Mouse_Pos();
+    void strokeStarted(QPoint pos);
+    void strokeMoved(QPoint pos);
+    void strokeFinished();
 };
 
 #endif
@@ -0,0 +1,41 @@
+#include "stroke_engine.h"
+
+StrokeEngine::StrokeEngine(Canvas *canvas, QRgb color)
+    : canvas(canvas), color(color)
+{
+}
+
+void StrokeEngine::begin(const QPoint& p)
+{
+    // finish the previous stroke first so it isn't joined to this one
+    rasterisePending();
+    hasLast = false;
+    active = true;
+    pending.append(p);
+}
+
+void StrokeEngine::addSample(const QPoint& p)
+{
+    if (!active) return;
+    const QPoint& prev = pending.isEmpty() ? last : pending.last();
+    if (p == prev) return;
+    pending.append(p);
+}
+
+void StrokeEngine::end()
+{
+    active = false;
+}
+
+void StrokeEngine::rasterisePending()
+{
+    for (const QPoint& p : pending) {
+        if (hasLast)
+            canvas->drawLineBresenham(last, p, color);
+        else
+            canvas->setPixel(p.x(), p.y(), color);
+        last = p;
+        hasLast = true;
+    }
+    pending.clear();
+}
@@ -0,0 +1,34 @@
+#ifndef STROKE_ENGINE_H
+#define STROKE_ENGINE_H
+
+#include <QPoint>
+#include <QVector>
+#include "canvas.h"
+
+// Collects freehand mouse samples between frames and joins consecutive samples with
+// Bresenham segments when the frame is rendered, so fast drags leave no gaps.
+class StrokeEngine
+{
+public:
+    explicit StrokeEngine(Canvas *canvas, QRgb color = qRgb(255, 0, 0));
+
+    void begin(const QPoint& p);
+    void addSample(const QPoint& p);
+    void end();
+
+    bool isActive() const { return active; }
+    bool hasPending() const { return !pending.isEmpty(); }
+
+    // Draw everything queued since the last call into the canvas.
+    void rasterisePending();
+
+private:
+    Canvas *canvas;
+    QRgb color;
+    QVector<QPoint> pending;
+    QPoint last;
+    bool hasLast = false;
+    bool active = false;
+};
+
+#endif // STROKE_ENGINE_H
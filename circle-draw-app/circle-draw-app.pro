@@ -1,4 +1,4 @@
-QT += widgets
+QT += widgets concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -11,17 +11,28 @@ CONFIG += c++17
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
+    circlebatch.cpp \
     gridscene.cpp \
-    gridview.cpp
+    gridview.cpp \
+    sweepbench.cpp \
+    sweepplot.cpp
 
 HEADERS += \
     mainwindow.h \
     gridscene.h \
-    gridview.h
+    gridview.h \
+    circlekernel.h \
+    circlebatch.h \
+    linekernel.h \
+    sweepbench.h \
+    sweepplot.h
 
 FORMS += \
     mainwindow.ui
 
+# Benchmark builds only: count heap allocations in the size sweep by replacing malloc
+sweep_alloc_count: DEFINES += SWEEP_COUNT_ALLOCATIONS
+
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
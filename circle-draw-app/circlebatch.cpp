@@ -0,0 +1,61 @@
+#include "circlebatch.h"
+#include "circlekernel.h"
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+
+namespace CircleBatch {
+
+QVector<QPoint> outlines(const QVector<Job>& jobs, bool parallel)
+{
+    const int n = jobs.size();
+    QVector<int> offset(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+        offset[i + 1] = offset[i] + CircleKernel::midpointCapacity(jobs[i].radius);
+
+    QVector<QPoint> cells(offset[n]);
+    QVector<int> count(n, 0);
+    QPoint *base = cells.data();
+    int *counts = count.data();
+    auto rasterise = [&](int i) {
+        QPoint *out = base + offset[i];
+        CircleKernel::midpointUnique(jobs[i].center, jobs[i].radius, [&](int x, int y) { *out++ = QPoint(x, y); });
+        counts[i] = int(out - (base + offset[i]));
+    };
+
+    if (parallel && n > 1) {
+        QVector<int> ids(n);
+        std::iota(ids.begin(), ids.end(), 0);
+        QtConcurrent::blockingMap(ids, rasterise);
+    } else {
+        for (int i = 0; i < n; ++i) rasterise(i);
+    }
+
+    int packed = 0;
+    for (int i = 0; i < n; ++i) {
+        std::copy(base + offset[i], base + offset[i] + count[i], base + packed);
+        packed += count[i];
+    }
+    cells.resize(packed);
+    return cells;
+}
+
+QVector<Job> concentric(const QPoint& center, int maxRadius)
+{
+    QVector<Job> jobs;
+    jobs.reserve(qMax(0, maxRadius));
+    for (int r = 1; r <= maxRadius; ++r) jobs.append({ center, r });
+    return jobs;
+}
+
+QVector<Job> grid(const QPoint& origin, int columns, int rows, int spacing, int radius)
+{
+    QVector<Job> jobs;
+    jobs.reserve(qMax(0, columns * rows));
+    for (int j = 0; j < rows; ++j)
+        for (int i = 0; i < columns; ++i)
+            jobs.append({ QPoint(origin.x() + i * spacing, origin.y() + j * spacing), radius });
+    return jobs;
+}
+
+} // namespace CircleBatch
@@ -0,0 +1,27 @@
+#ifndef CIRCLEBATCH_H
+#define CIRCLEBATCH_H
+
+#include <QPoint>
+#include <QVector>
+
+// Many circles rasterised together, e.g. every radius 1..N around one centre or a grid of
+// centres, so a test scene costs one scene commit instead of a redraw per circle.
+namespace CircleBatch {
+
+struct Job {
+    QPoint center;
+    int radius;
+};
+
+// Midpoint outline cells of every job, each circle's cells once, circles in job order. With
+// `parallel`, circles are handed out to the thread pool one per task. Each task writes into
+// its own slice of one buffer sized from the capacity bounds, and the slices are packed
+// together afterwards.
+QVector<QPoint> outlines(const QVector<Job>& jobs, bool parallel = true);
+
+QVector<Job> concentric(const QPoint& center, int maxRadius);
+QVector<Job> grid(const QPoint& origin, int columns, int rows, int spacing, int radius);
+
+} // namespace CircleBatch
+
+#endif // CIRCLEBATCH_H
@@ -0,0 +1,492 @@
+#ifndef CIRCLEKERNEL_H
+#define CIRCLEKERNEL_H
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Circle generators that pass each point straight to a plot(x, y) callback, with no per-step
+// containers and no allocation. Every generator visits the same samples and emits the eight
+// mirrored points in the same order as MainWindow::eightSymmetry, so the output sequence
+// matches the container-based builders point for point.
+namespace CircleKernel {
+
+template <typename Plot>
+inline void plot8(const QPoint& c, int x, int y, Plot& plot)
+{
+    plot(c.x() + x, c.y() + y);
+    plot(c.x() - x, c.y() + y);
+    plot(c.x() + x, c.y() - y);
+    plot(c.x() - x, c.y() - y);
+    plot(c.x() + y, c.y() + x);
+    plot(c.x() - y, c.y() + x);
+    plot(c.x() + y, c.y() - x);
+    plot(c.x() - y, c.y() - x);
+}
+
+// First-octant samples (x, y) of each method, before mirroring.
+template <typename Plot>
+void midpointOctant(int r, Plot&& plot)
+{
+    int x = 0, y = r, p = 1 - r;
+    while (x <= y) {
+        plot(x, y);
+        ++x;
+        if (p < 0) p += 2 * x + 1;
+        else { --y; p += 2 * (x - y) + 1; }
+    }
+}
+
+template <typename Plot>
+void polarOctant(int r, Plot&& plot)
+{
+    const double dtheta = 1.0 / qMax(1, r);
+    for (double t = 0.0; t <= M_PI/4.0 + 1e-9; t += dtheta)
+        plot(int(qRound(r * qCos(t))), int(qRound(r * qSin(t))));
+}
+
+// Same angles as polarOctant, but (cos t, sin t) is advanced by a fixed rotation instead of
+// calling qCos/qSin each step. Every 32 steps the vector is pulled back to unit length
+// (one Newton step towards 1/|v|, no sqrt), so the drift stays at rounding-error level.
+template <typename Plot>
+void polarRecurrenceOctant(int r, Plot&& plot)
+{
+    const double dtheta = 1.0 / qMax(1, r);
+    const double cd = qCos(dtheta), sd = qSin(dtheta);
+    double cs = 1.0, sn = 0.0;
+    int step = 0;
+    for (double t = 0.0; t <= M_PI/4.0 + 1e-9; t += dtheta) {
+        plot(int(qRound(r * cs)), int(qRound(r * sn)));
+        const double c2 = cs * cd - sn * sd;
+        sn = sn * cd + cs * sd;
+        cs = c2;
+        if ((++step & 31) == 0) {
+            const double k = 0.5 * (3.0 - (cs * cs + sn * sn));
+            cs *= k;
+            sn *= k;
+        }
+    }
+}
+
+// r^2 is formed in double, since it overflows int once r passes 46340
+template <typename Plot>
+void cartesianOctant(int r, Plot&& plot)
+{
+    for (int x = 0; x <= r; ++x)
+        plot(x, int(qRound(qSqrt(double(r) * r - double(x) * x))));
+}
+
+template <typename Plot>
+void midpoint(const QPoint& c, int r, Plot&& plot)
+{
+    midpointOctant(r, [&](int x, int y) { plot8(c, x, y, plot); });
+}
+
+template <typename Plot>
+void polar(const QPoint& c, int r, Plot&& plot)
+{
+    polarOctant(r, [&](int x, int y) { plot8(c, x, y, plot); });
+}
+
+template <typename Plot>
+void polarRecurrence(const QPoint& c, int r, Plot&& plot)
+{
+    polarRecurrenceOctant(r, [&](int x, int y) { plot8(c, x, y, plot); });
+}
+
+template <typename Plot>
+void cartesian(const QPoint& c, int r, Plot&& plot)
+{
+    cartesianOctant(r, [&](int x, int y) { plot8(c, x, y, plot); });
+}
+
+// Filled disk as one span(y, x0, x1) per row, 2r + 1 in all, taken from the midpoint
+// decision variable. At step (x, y), rows +-x reach out to +-y. Rows +-y are emitted when y is
+// about to drop, because that x is the widest they get. Rows with y == x have already been
+// emitted as x rows.
+template <typename Span>
+void filledMidpoint(const QPoint& c, int r, Span&& span)
+{
+    int x = 0, y = r, p = 1 - r;
+    while (x <= y) {
+        span(c.y() + x, c.x() - y, c.x() + y);
+        if (x != 0) span(c.y() - x, c.x() - y, c.x() + y);
+        if (p >= 0 && y != x) {
+            span(c.y() + y, c.x() - x, c.x() + x);
+            span(c.y() - y, c.x() - x, c.x() + x);
+        }
+        ++x;
+        if (p < 0) p += 2 * x + 1;
+        else { --y; p += 2 * (x - y) + 1; }
+    }
+}
+
+// For each row 0..r above the centre, the nearest and farthest |x| of the midpoint outline
+// (rows of the first quadrant are (u, v) and (v, u) for every octant sample). nearest[h] - 1 is
+// the half-width of the cells strictly inside the outline on row h; farthest[h] is the disk's.
+inline void outlineRows(int r, QVector<int>& nearest, QVector<int>& farthest)
+{
+    nearest.fill(std::numeric_limits<int>::max(), r + 1);
+    farthest.fill(-1, r + 1);
+    midpointOctant(r, [&](int u, int v) {
+        nearest[u] = qMin(nearest[u], v); farthest[u] = qMax(farthest[u], v);
+        nearest[v] = qMin(nearest[v], u); farthest[v] = qMax(farthest[v], u);
+    });
+}
+
+// Thick ring from the inner midpoint circle ri out to the outer one ro, both included, as
+// spans. It is the outer disk minus the cells strictly inside the inner outline. So each row
+// is one span where the inner circle does not reach it, and two otherwise. Rows never
+// overlap, and every cell between the two outlines is covered. ri == ro gives exactly the
+// midpoint outline. The cost is two outline walks plus one or two span writes per row.
+template <typename Span>
+void annulus(const QPoint& c, int ri, int ro, Span&& span)
+{
+    if (ri > ro) std::swap(ri, ro);
+    if (ro < 0) return;
+    QVector<int> outerNear, outerFar, innerNear, innerFar;
+    outlineRows(ro, outerNear, outerFar);
+    if (ri >= 0) outlineRows(ri, innerNear, innerFar);
+
+    auto row = [&](int y, int reach, int hole) {
+        if (hole < 1) { span(y, c.x() - reach, c.x() + reach); return; }
+        span(y, c.x() - reach, c.x() - hole);
+        span(y, c.x() + hole, c.x() + reach);
+    };
+    for (int h = 0; h <= ro; ++h) {
+        const int hole = h <= ri ? qMin(innerNear[h], outerFar[h] + 1) : 0;
+        row(c.y() - h, outerFar[h], hole);
+        if (h != 0) row(c.y() + h, outerFar[h], hole);
+    }
+}
+
+// Anti-aliased circles. Coverage is a box filter of the signed distance d = |(x, y)| - r in
+// cells. Each row is walked inwards from the outermost cell that can be touched. s = x^2 + y^2
+// is stepped as s -= 2x - 1, so each cell costs one sqrt. The walk stops where the shape
+// becomes solid, so the interior is never visited.
+
+// One-cell-wide stroke centred on radius r. plot(x, y, coverage) gets each cell with
+// coverage 1 - |d| > 0, once.
+template <typename Plot>
+void antialiasedOutline(const QPoint& c, int r, Plot&& plot)
+{
+    if (r < 0) return;
+    const qint64 reach = qint64(r + 1) * (r + 1);
+    for (int y = -(r + 1); y <= r + 1; ++y) {
+        const qint64 yy = qint64(y) * y;
+        qint64 x = qint64(std::sqrt(double(reach - yy))) + 1;
+        qint64 s = x * x + yy;
+        for (; x >= 0; s -= 2 * x - 1, --x) {
+            const double d = std::sqrt(double(s)) - r;
+            if (d <= -1.0) break;
+            if (d >= 1.0) continue;
+            plot(c.x() + int(x), c.y() + y, 1.0 - qAbs(d));
+            if (x != 0) plot(c.x() - int(x), c.y() + y, 1.0 - qAbs(d));
+        }
+    }
+}
+
+// Disk with its edge at r + 1/2, the outer edge of the stroke above. Each row's solid run
+// goes to span(y, x0, x1), and the partly covered cells outside it go to
+// plot(x, y, coverage), where coverage = r + 1 - |(x, y)|.
+template <typename Span, typename Plot>
+void antialiasedDisk(const QPoint& c, int r, Span&& span, Plot&& plot)
+{
+    if (r < 0) return;
+    const qint64 reach = qint64(r + 1) * (r + 1);
+    for (int y = -(r + 1); y <= r + 1; ++y) {
+        const qint64 yy = qint64(y) * y;
+        qint64 x = qint64(std::sqrt(double(reach - yy))) + 1;
+        qint64 s = x * x + yy;
+        for (; x >= 0; s -= 2 * x - 1, --x) {
+            const double coverage = r + 1 - std::sqrt(double(s));
+            if (coverage >= 1.0) { span(c.y() + y, c.x() - int(x), c.x() + int(x)); break; }
+            if (coverage <= 0.0) continue;
+            plot(c.x() + int(x), c.y() + y, coverage);
+            if (x != 0) plot(c.x() - int(x), c.y() + y, coverage);
+        }
+    }
+}
+
+// Midpoint y at column x (0 <= x <= y) without stepping there. p < 0 is the test
+// (x + 1)^2 + y (y - 1) < r^2 one column ahead, and y drops by at most one per column. So the
+// loop always holds the largest y with x^2 + y (y - 1) < r^2.
+inline int midpointColumn(int r, int x)
+{
+    const qint64 D = qint64(r) * r - qint64(x) * x;
+    qint64 y = qint64((1.0 + qSqrt(1.0 + 4.0 * double(D))) / 2.0);
+    while (y > 0 && y * y - y >= D) --y;
+    while ((y + 1) * y < D) ++y;
+    return int(y);
+}
+
+// midpointOctant restricted to columns x0..x1, entered at x0 in closed form
+template <typename Plot>
+void midpointOctantRange(int r, int x0, int x1, Plot&& plot)
+{
+    int x = qMax(0, x0), y = midpointColumn(r, x);
+    int p = int(qint64(x + 1) * (x + 1) + qint64(y) * (y - 1) - qint64(r) * r);
+    while (x <= y && x <= x1) {
+        plot(x, y);
+        ++x;
+        if (p < 0) p += 2 * x + 1;
+        else { --y; p += 2 * (x - y) + 1; }
+    }
+}
+
+// Octant k of the circle, in screen angles (0 is +x, counterclockwise, y up), as the
+// first-octant sample (u, v) with u <= v seen from that octant. Even octants run away from
+// an axis and odd ones towards it.
+inline QPoint octantCell(const QPoint& c, int k, int u, int v)
+{
+    switch (k & 7) {
+    case 0: return QPoint(c.x() + v, c.y() - u);
+    case 1: return QPoint(c.x() + u, c.y() - v);
+    case 2: return QPoint(c.x() - u, c.y() - v);
+    case 3: return QPoint(c.x() - v, c.y() - u);
+    case 4: return QPoint(c.x() - v, c.y() + u);
+    case 5: return QPoint(c.x() - u, c.y() + v);
+    case 6: return QPoint(c.x() + u, c.y() + v);
+    default: return QPoint(c.x() + v, c.y() + u);
+    }
+}
+
+// The cells of midpointUnique that lie in `view` (cell coordinates, edges included), each
+// once, octant by octant. In an octant one screen coordinate moves with u and the other with
+// v, and v never rises as u grows. So the octant's visible cells are one run of columns: the
+// u bound is linear, and the v bound is found by bisection on midpointColumn. Only that run
+// is stepped, so the cost follows the visible perimeter plus O(log r) per octant.
+template <typename Plot>
+void visibleMidpoint(const QPoint& c, int r, const QRect& view, Plot&& plot)
+{
+    if (r < 0 || view.isEmpty()) return;
+    if (r == 0) { if (view.contains(c)) plot(c.x(), c.y()); return; }
+
+    // t range where origin + step * t lies in [lo, hi], for step = +-1
+    auto run = [](int origin, int step, int lo, int hi) {
+        return step > 0 ? QPoint(lo - origin, hi - origin) : QPoint(origin - hi, origin - lo);
+    };
+    for (int k = 0; k < 8; ++k) {
+        const QPoint du = octantCell(c, k, 1, 0) - c, dv = octantCell(c, k, 0, 1) - c;
+        const QPoint uRange = du.x() != 0 ? run(c.x(), du.x(), view.left(), view.right())
+                                          : run(c.y(), du.y(), view.top(), view.bottom());
+        const QPoint vRange = dv.x() != 0 ? run(c.x(), dv.x(), view.left(), view.right())
+                                          : run(c.y(), dv.y(), view.top(), view.bottom());
+        if (vRange.y() < 0 || vRange.x() > r || uRange.y() < 0) continue;
+
+        // first column with v <= vRange.y(), and last with v >= vRange.x()
+        int lo = 0, hi = r;
+        if (midpointColumn(r, 0) > vRange.y()) {
+            while (hi - lo > 1) {
+                const int mid = lo + (hi - lo) / 2;
+                (midpointColumn(r, mid) > vRange.y() ? lo : hi) = mid;
+            }
+            lo = hi;
+        }
+        const int first = lo;
+        lo = 0; hi = r;
+        if (midpointColumn(r, r) < vRange.x()) {
+            while (hi - lo > 1) {
+                const int mid = lo + (hi - lo) / 2;
+                (midpointColumn(r, mid) >= vRange.x() ? lo : hi) = mid;
+            }
+            hi = lo;
+        }
+        const int last = hi;
+
+        const int u0 = qMax(first, uRange.x()), u1 = qMin(last, uRange.y());
+        if (u0 > u1) continue;
+        const bool odd = (k & 1) != 0;
+        midpointOctantRange(r, u0, u1, [&](int u, int v) {
+            if (odd && (u == 0 || u == v)) return;
+            const QPoint p = octantCell(c, k, u, v);
+            plot(p.x(), p.y());
+        });
+    }
+}
+
+// Arc of the midpoint circle from startDeg counterclockwise through sweepDeg (0 is +x and 90
+// is up on screen). A cell is on the arc when its centre's angle lies in the closed range.
+// Each octant the arc touches is entered near the column where the arc starts there (the
+// column is about r sin of the local angle, and midpointColumn supplies y). It is left as
+// soon as the arc ends, so only the arc's own cells and a couple of lead-in columns are
+// stepped. Cells on the axes and diagonals belong to the even octants only, so none repeats.
+// Cells come out octant by octant.
+template <typename Plot>
+void arc(const QPoint& c, int r, double startDeg, double sweepDeg, Plot&& plot)
+{
+    if (sweepDeg <= 0.0) return;
+    if (r < 0) return;
+    if (r == 0) { plot(c.x(), c.y()); return; }
+    double lo = 0.0, hi = 360.0;
+    int octants = 8;
+    if (sweepDeg < 360.0) {
+        lo = std::fmod(startDeg, 360.0);
+        if (lo < 0.0) lo += 360.0;
+        hi = lo + sweepDeg;
+        octants = 16;   // the range may run past 360
+    }
+    const double eps = 1e-9 * qMax(1, r);
+    for (int k = 0; k < octants; ++k) {
+        const double from = qMax(lo, 45.0 * k), to = qMin(hi, 45.0 * (k + 1));
+        if (from > to) continue;
+        const bool odd = (k & 1) != 0;
+        // local angle from the octant's axis, [0, 45] degrees
+        const double a0 = qDegreesToRadians(odd ? 45.0 * (k + 1) - to : from - 45.0 * k);
+        const double a1 = qDegreesToRadians(odd ? 45.0 * (k + 1) - from : to - 45.0 * k);
+        const double s0 = qSin(a0), c0 = qCos(a0), s1 = qSin(a1), c1 = qCos(a1);
+        midpointOctantRange(r, int(r * s0) - 2, int(r * s1) + 2, [&](int u, int v) {
+            if (u * c0 < v * s0 - eps || u * c1 > v * s1 + eps) return;
+            if (odd && (u == 0 || u == v)) return;
+            const QPoint p = octantCell(c, k, u, v);
+            plot(p.x(), p.y());
+        });
+    }
+}
+
+// The cell of the midpoint circle nearest to the ray at angleDeg, for joining arcs to
+// chords and radii
+inline QPoint arcPoint(const QPoint& c, int r, double angleDeg)
+{
+    double phi = std::fmod(angleDeg, 360.0);
+    if (phi < 0.0) phi += 360.0;
+    const int k = qMin(7, int(phi / 45.0));
+    const double local = (k & 1) ? 45.0 * (k + 1) - phi : phi - 45.0 * k;
+    const double a = qDegreesToRadians(local);
+    QPoint best;
+    double bestErr = -1.0;
+    midpointOctantRange(r, int(r * qSin(a)) - 2, int(r * qSin(a)) + 2, [&](int u, int v) {
+        const double err = qAbs(std::atan2(double(u), double(qMax(v, 1))) - a);
+        if (bestErr < 0.0 || err < bestErr) { bestErr = err; best = octantCell(c, k, u, v); }
+    });
+    return bestErr < 0.0 ? c : best;
+}
+
+// The midpoint circle with each cell once and no buffer: the eight octant images of every
+// sample, minus those that land on an axis or diagonal a second time (as in arc)
+template <typename Plot>
+void midpointUnique(const QPoint& c, int r, Plot&& plot)
+{
+    if (r < 0) return;
+    if (r == 0) { plot(c.x(), c.y()); return; }
+    midpointOctant(r, [&](int u, int v) {
+        for (int k = 0; k < 8; ++k) {
+            if ((k & 1) && (u == 0 || u == v)) continue;
+            const QPoint p = octantCell(c, k, u, v);
+            plot(p.x(), p.y());
+        }
+    });
+}
+
+// Filled sector (pie slice) as spans: each row of filledMidpoint is cut to the cells whose
+// centres lie in the wedge from startDeg through sweepDeg. In up-coordinates (X, Y), a cell
+// is on the inner side of the start ray when cs Y - ss X >= 0, and on the inner side of the end
+// ray when ce Y - se X <= 0. Both tests hold up to 180 degrees, and either one beyond it.
+// Per row each test is a half-line in X, so a row gives at most two spans. The centre cell
+// is always included.
+template <typename Span>
+void filledSector(const QPoint& c, int r, double startDeg, double sweepDeg, Span&& span)
+{
+    if (sweepDeg <= 0.0) return;
+    if (sweepDeg >= 360.0) { filledMidpoint(c, r, span); return; }
+    const double inf = std::numeric_limits<double>::infinity();
+    const double tiny = 1e-12, eps = 1e-9 * qMax(1, r);
+    const double s = qDegreesToRadians(startDeg), e = qDegreesToRadians(startDeg + sweepDeg);
+    const double cs = qCos(s), ss = qSin(s), ce = qCos(e), se = qSin(e);
+
+    struct Range { double lo, hi; };
+    auto afterStart = [&](double Y) -> Range {      // cs Y - ss X >= 0
+        if (ss > tiny) return { -inf, cs * Y / ss };
+        if (ss < -tiny) return { cs * Y / ss, inf };
+        return cs * Y >= -eps ? Range{ -inf, inf } : Range{ inf, -inf };
+    };
+    auto beforeEnd = [&](double Y) -> Range {       // se X >= ce Y
+        if (se > tiny) return { ce * Y / se, inf };
+        if (se < -tiny) return { -inf, ce * Y / se };
+        return ce * Y <= eps ? Range{ -inf, inf } : Range{ inf, -inf };
+    };
+    auto cells = [&](const Range& rg, int x0, int x1, int& a, int& b) {
+        a = rg.lo == -inf ? x0 : qMax(x0, int(qCeil(rg.lo - eps)));
+        b = rg.hi == inf ? x1 : qMin(x1, int(qFloor(rg.hi + eps)));
+        return a <= b;
+    };
+
+    filledMidpoint(QPoint(0, 0), r, [&](int y, int x0, int x1) {
+        const double Y = -y;
+        const Range p = afterStart(Y), q = beforeEnd(Y);
+        int a, b, a2, b2;
+        if (sweepDeg <= 180.0) {
+            if (cells({ qMax(p.lo, q.lo), qMin(p.hi, q.hi) }, x0, x1, a, b))
+                span(c.y() + y, c.x() + a, c.x() + b);
+            return;
+        }
+        const bool first = cells(p, x0, x1, a, b), second = cells(q, x0, x1, a2, b2);
+        if (first && second && a2 <= b + 1 && a <= b2 + 1) {
+            span(c.y() + y, c.x() + qMin(a, a2), c.x() + qMax(b, b2));
+        } else {
+            if (first) span(c.y() + y, c.x() + a, c.x() + b);
+            if (second) span(c.y() + y, c.x() + a2, c.x() + b2);
+        }
+    });
+}
+
+// Emit the eight-way mirror of `samples` as each cell once, in angular order, starting at
+// (0, r) and heading towards +x. The mirror images of (x, y) are those of (min, max) of
+// |x| and |y|, so every sample is folded into 0 <= u <= v. The samples are then ordered by
+// angle and repeats are dropped. Each octant is walked alternately forwards and backwards.
+// Images of two octants can only coincide on a mirror line (u == 0 or u == v), so those
+// samples are skipped in whichever octant would repeat them. `samples` is reordered in
+// place. Returns the number of cells emitted.
+template <typename Plot>
+int traceOctants(QVector<QPoint>& samples, const QPoint& c, Plot&& plot)
+{
+    for (QPoint& s : samples) {
+        const int u = qAbs(s.x()), v = qAbs(s.y());
+        s = QPoint(qMin(u, v), qMax(u, v));
+    }
+    auto before = [](const QPoint& p, const QPoint& q) {
+        const qint64 lhs = qint64(p.x()) * q.y(), rhs = qint64(q.x()) * p.y();
+        return lhs != rhs ? lhs < rhs : p.y() < q.y();
+    };
+    if (!std::is_sorted(samples.begin(), samples.end(), before))
+        std::sort(samples.begin(), samples.end(), before);
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    const int n = samples.size();
+    int emitted = 0;
+    auto put = [&](int x, int y) { plot(c.x() + x, c.y() + y); ++emitted; };
+    for (int o = 0; o < 8; ++o) {
+        const bool forward = (o % 2) == 0;
+        for (int k = 0; k < n; ++k) {
+            const QPoint& s = samples[forward ? k : n - 1 - k];
+            const int u = s.x(), v = s.y();
+            if (o > 0 && forward && u == 0) continue;     // on an axis: already emitted
+            if (!forward && u == v) continue;             // on a diagonal: already emitted
+            if (o == 7 && u == 0) continue;               // back at the start
+            switch (o) {
+            case 0: put( u,  v); break;
+            case 1: put( v,  u); break;
+            case 2: put( v, -u); break;
+            case 3: put( u, -v); break;
+            case 4: put(-u, -v); break;
+            case 5: put(-v, -u); break;
+            case 6: put(-v,  u); break;
+            default: put(-u,  v); break;
+            }
+        }
+    }
+    return emitted;
+}
+
+// Upper bounds on the points each generator emits, so a buffer can be sized once up front.
+inline int midpointCapacity(int r) { return 8 * (int(qMax(0, r) * M_SQRT1_2) + 2); }
+inline int polarCapacity(int r)    { return 8 * (int((M_PI/4.0 + 1e-9) * qMax(1, r)) + 2); }
+inline int cartesianCapacity(int r) { return 8 * (qMax(0, r) + 1); }
+
+} // namespace CircleKernel
+
+#endif // CIRCLEKERNEL_H
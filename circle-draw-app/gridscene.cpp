@@ -1,31 +1,158 @@
 #include "gridscene.h"
 #include <QGraphicsSceneMouseEvent>
+#include <QHash>
 #include <QPainter>
+#include <algorithm>
 
 GridScene::GridScene(QObject* parent) : QGraphicsScene(parent) {
     setSceneRect(-5000, -5000, 10000, 10000);
 }
 
 void GridScene::toggleCell(const QPoint& cell) {
-    if (coloredCells.size() >= 2)
+    commitLiveCells();
+    if (coloredCells.size() >= 2) {
         coloredCells.clear();
+        cellIndex.clear();
+    }
 
+    cellIndex.insert(cell, coloredCells.size());
     coloredCells.append(qMakePair(cell, QBrush(Qt::magenta)));
     update(QRectF(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize));
 }
 
 
 void GridScene::paintCell(const QPoint& cell, const QBrush& brush) {
-    for (int i = 0; i < coloredCells.size(); ++i) {
-        if (coloredCells[i].first == cell) {
-            coloredCells[i].second = brush;
-            update(QRectF(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize));
-            return;
+    commitLiveCells();
+    storeCell(cell, brush);
+    update(QRectF(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize));
+}
+
+void GridScene::storeCell(const QPoint& cell, const QBrush& brush) {
+    auto it = cellIndex.find(cell);
+    if (it != cellIndex.end()) {
+        coloredCells[it.value()].second = brush;
+    } else {
+        cellIndex.insert(cell, coloredCells.size());
+        coloredCells.append(qMakePair(cell, brush));
+    }
+}
+
+// Swap the last cell into the removed one's slot; cells never overlap, so their order is free
+void GridScene::removeCell(const QPoint& cell) {
+    auto it = cellIndex.find(cell);
+    if (it == cellIndex.end()) return;
+    const int i = it.value();
+    cellIndex.erase(it);
+    if (i != coloredCells.size() - 1) {
+        coloredCells[i] = coloredCells.last();
+        cellIndex[coloredCells[i].first] = i;
+    }
+    coloredCells.removeLast();
+}
+
+void GridScene::setLiveCells(const QHash<QPoint, QBrush>& cells) {
+    QVector<QPoint> changed;
+    for (auto it = liveCells.cbegin(); it != liveCells.cend(); ++it) {
+        auto next = cells.constFind(it.key());
+        if (next == cells.cend() || next.value() != it.value()) changed.append(it.key());
+    }
+    for (auto it = cells.cbegin(); it != cells.cend(); ++it)
+        if (!liveCells.contains(it.key())) changed.append(it.key());
+    liveCells = cells;
+    updateCells(changed);
+}
+
+// The overlay already shows these cells, so storing them needs no repaint
+void GridScene::commitLiveCells() {
+    if (liveCells.isEmpty()) return;
+    for (auto it = liveCells.cbegin(); it != liveCells.cend(); ++it)
+        storeCell(it.key(), it.value());
+    liveCells.clear();
+}
+
+// One update per horizontal run of cells, so scattered changes don't expose their bounding box
+void GridScene::updateCells(QVector<QPoint> cells) {
+    std::sort(cells.begin(), cells.end(), [](const QPoint& a, const QPoint& b) {
+        return a.y() < b.y() || (a.y() == b.y() && a.x() < b.x());
+    });
+    for (int i = 0; i < cells.size();) {
+        int j = i + 1;
+        while (j < cells.size() && cells[j].y() == cells[i].y() && cells[j].x() <= cells[j - 1].x() + 1)
+            ++j;
+        update(QRectF(cells[i].x() * cellSize, cells[i].y() * cellSize,
+                      (cells[j - 1].x() - cells[i].x() + 1) * cellSize, cellSize));
+        i = j;
+    }
+}
+
+void GridScene::paintCells(const QVector<QPoint>& cells, const QBrush& brush) {
+    if (cells.isEmpty()) return;
+    commitLiveCells();
+
+    cellIndex.reserve(coloredCells.size() + cells.size());
+    coloredCells.reserve(coloredCells.size() + cells.size());
+    for (const QPoint& cell : cells)
+        storeCell(cell, brush);
+    update();
+}
+
+void GridScene::paintSpan(int y, int x0, int x1, const QBrush& brush) {
+    if (x1 < x0) return;
+    commitLiveCells();
+
+    // Spans are drawn beneath the cells, so the cells this span covers must go for it to show.
+    // Older spans are cut back to what lies outside it, which keeps each row's spans disjoint
+    // and bounded by the row's width however often the same area is refilled.
+    if (!coloredCells.isEmpty())
+        for (int x = x0; x <= x1; ++x) removeCell(QPoint(x, y));
+
+    QVector<Span>& row = coloredSpans[y];
+    QVector<Span> kept;
+    kept.reserve(row.size() + 2);
+    for (const Span& s : row) {
+        if (s.x1 < x0 || s.x0 > x1) {
+            kept.append(s);
+            continue;
         }
+        if (s.x0 < x0) kept.append({ s.x0, x0 - 1, s.brush });
+        if (s.x1 > x1) kept.append({ x1 + 1, s.x1, s.brush });
     }
+    kept.append({ x0, x1, brush });
+    row = kept;
+    update(QRectF(x0 * cellSize, y * cellSize, (x1 - x0 + 1) * cellSize, cellSize));
+}
 
-    coloredCells.append(qMakePair(cell, brush));
-    update(QRectF(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize));
+// Porter-Duff source-over of `src` at opacity `alpha` onto `dst`
+static QColor sourceOver(const QColor& src, qreal alpha, const QColor& dst) {
+    const qreal dstAlpha = dst.alphaF();
+    const qreal outAlpha = alpha + dstAlpha * (1.0 - alpha);
+    if (outAlpha <= 0.0) return QColor(0, 0, 0, 0);
+    auto mix = [&](qreal s, qreal d) { return (s * alpha + d * dstAlpha * (1.0 - alpha)) / outAlpha; };
+    return QColor::fromRgbF(mix(src.redF(), dst.redF()), mix(src.greenF(), dst.greenF()),
+                            mix(src.blueF(), dst.blueF()), outAlpha);
+}
+
+void GridScene::blendCells(const QVector<QPair<QPoint, qreal>>& cells, const QColor& color) {
+    if (cells.isEmpty()) return;
+    commitLiveCells();
+
+    cellIndex.reserve(coloredCells.size() + cells.size());
+    coloredCells.reserve(coloredCells.size() + cells.size());
+    for (const QPair<QPoint, qreal>& c : cells) {
+        const qreal alpha = qBound<qreal>(0.0, c.second, 1.0) * color.alphaF();
+        auto it = cellIndex.find(c.first);
+        if (it != cellIndex.end()) {
+            QBrush& brush = coloredCells[it.value()].second;
+            brush = QBrush(sourceOver(color, alpha, brush.color()));
+        } else {
+            // no cell yet: the painter blends it over the grid when it is drawn
+            QColor src = color;
+            src.setAlphaF(alpha);
+            cellIndex.insert(c.first, coloredCells.size());
+            coloredCells.append(qMakePair(c.first, QBrush(src)));
+        }
+    }
+    update();
 }
 
 void GridScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
@@ -77,8 +204,18 @@ void GridScene::drawBackground(QPainter* painter, const QRectF& rect) {
     }
 
 
-    // colored cells
+    // colored spans, then cells on top; a cell only outlives the spans painted before it
     painter->setPen(Qt::NoPen);
+    for (auto row = coloredSpans.cbegin(); row != coloredSpans.cend(); ++row) {
+        if (row.key() < top || row.key() > bottom) continue;
+        for (const Span& s : row.value()) {
+            QRectF r(s.x0 * cellSize, row.key() * cellSize, (s.x1 - s.x0 + 1) * cellSize, cellSize);
+            painter->setBrush(s.brush);
+            if (rect.intersects(r))
+                painter->drawRect(r);
+        }
+    }
+
     for (const QPair<QPoint, QBrush>& p : coloredCells) {
         QRectF r(p.first.x() * cellSize, p.first.y() * cellSize, cellSize, cellSize);
         painter->setBrush(p.second);
@@ -87,7 +224,25 @@ void GridScene::drawBackground(QPainter* painter, const QRectF& rect) {
     }
 }
 
+void GridScene::drawForeground(QPainter* painter, const QRectF& rect) {
+    painter->setPen(Qt::NoPen);
+    for (auto it = liveCells.cbegin(); it != liveCells.cend(); ++it) {
+        QRectF r(it.key().x() * cellSize, it.key().y() * cellSize, cellSize, cellSize);
+        painter->setBrush(it.value());
+        if (rect.intersects(r))
+            painter->drawRect(r);
+    }
+}
+
+QRect GridScene::cellsIn(const QRectF& area) const {
+    return QRect(QPoint(qFloor(area.left() / cellSize), qFloor(area.top() / cellSize)),
+                 QPoint(qFloor(area.right() / cellSize), qFloor(area.bottom() / cellSize)));
+}
+
 void GridScene::clearCells() {
     coloredCells.clear();
+    cellIndex.clear();
+    coloredSpans.clear();
+    liveCells.clear();
     update();
 }
@@ -1,8 +1,12 @@
 #include "mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "circlekernel.h"
+#include "linekernel.h"
+#include "sweepplot.h"
 
 #include <QElapsedTimer>
+#include <QHash>
 #include <QtMath>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -11,11 +15,25 @@
 #include <QLineEdit>
 #include <QIntValidator>
 #include <QSlider>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QSet>
 #include <QDebug>
 #include <QStatusBar>
+#include <QApplication>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QTableWidget>
 
 static QBrush kPolarBrush = QBrush(QColor(220, 20, 60));
+static QBrush kPolarRecurrenceBrush = QBrush(QColor(255, 140, 0));
 static QBrush kMidBrush   = QBrush(QColor(0, 90, 255));
+static QBrush kFillBrush  = QBrush(QColor(150, 190, 255));
+static QBrush kArcBrush   = QBrush(QColor(140, 40, 180));
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -47,23 +65,72 @@ MainWindow::MainWindow(QWidget *parent)
     inputRow->addSpacing(12);
     inputRow->addWidget(new QLabel("Live radius:"));
     inputRow->addWidget(radiusSlider);
+    inputRow->addSpacing(12);
+
+    thicknessInput = new QSpinBox();
+    thicknessInput->setRange(1, 100);
+    thicknessInput->setValue(3);
+    inputRow->addWidget(new QLabel("Thickness:"));
+    inputRow->addWidget(thicknessInput);
+    inputRow->addSpacing(12);
+
+    clipCheck = new QCheckBox("Clip to view");
+    clipCheck->setToolTip("Generate only the midpoint cells inside the visible area");
+    inputRow->addWidget(clipCheck);
     inputRow->addStretch();
 
+    auto *arcRow = new QHBoxLayout;
+    arcStartInput = new QSpinBox();
+    arcStartInput->setRange(0, 359);
+    arcStartInput->setSuffix(" deg");
+    arcSweepInput = new QSpinBox();
+    arcSweepInput->setRange(1, 360);
+    arcSweepInput->setValue(90);
+    arcSweepInput->setSuffix(" deg");
+    arcModeBox = new QComboBox();
+    arcModeBox->addItems({ "Arc", "Chord", "Sector", "Filled sector" });
+    auto *btnArc = new QPushButton("Draw Arc");
+
+    arcRow->addWidget(new QLabel("Start:"));
+    arcRow->addWidget(arcStartInput);
+    arcRow->addWidget(new QLabel("Sweep:"));
+    arcRow->addWidget(arcSweepInput);
+    arcRow->addWidget(arcModeBox);
+    arcRow->addWidget(btnArc);
+    arcRow->addStretch();
+
     auto *btnRow = new QHBoxLayout;
     auto *btnPolar = new QPushButton("Draw Circle (Polar)");
+    auto *btnPolarRec = new QPushButton("Draw Circle (Polar, no trig)");
     auto *btnMid   = new QPushButton("Draw Circle (Midpoint)");
     auto *btnCart  = new QPushButton("Draw Circle (Cartesian)");
+    auto *btnFill  = new QPushButton("Fill Circle");
+    auto *btnAA    = new QPushButton("Draw Circle (Anti-aliased)");
+    auto *btnFillAA = new QPushButton("Fill Circle (Anti-aliased)");
+    auto *btnThick = new QPushButton("Thick Circle");
+    auto *btnRings = new QPushButton("Concentric");
+    auto *btnGrid  = new QPushButton("Circle Grid");
     auto *btnClear = new QPushButton("Clear");
     auto *btnPerf  = new QPushButton("Compare Times");
+    auto *btnSweep = new QPushButton("Sweep Radii");
 
     btnRow->addWidget(btnPolar);
+    btnRow->addWidget(btnPolarRec);
     btnRow->addWidget(btnMid);
     btnRow->addWidget(btnCart);
+    btnRow->addWidget(btnFill);
+    btnRow->addWidget(btnAA);
+    btnRow->addWidget(btnFillAA);
+    btnRow->addWidget(btnThick);
+    btnRow->addWidget(btnRings);
+    btnRow->addWidget(btnGrid);
     btnRow->addWidget(btnPerf);
+    btnRow->addWidget(btnSweep);
     btnRow->addStretch();
     btnRow->addWidget(btnClear);
 
     mainLayout->addLayout(inputRow);
+    mainLayout->addLayout(arcRow);
     mainLayout->addWidget(view);
     mainLayout->addLayout(btnRow);
     setCentralWidget(central);
@@ -71,9 +138,18 @@ MainWindow::MainWindow(QWidget *parent)
     connect(scene, &GridScene::cellClicked, this, &MainWindow::onCellClicked);
     connect(radiusInput, &QLineEdit::textChanged, this, &MainWindow::onRadiusChanged);
     connect(btnPolar, &QPushButton::clicked, this, &MainWindow::drawCirclePolar);
+    connect(btnPolarRec, &QPushButton::clicked, this, &MainWindow::drawCirclePolarRecurrence);
     connect(btnMid,   &QPushButton::clicked, this, &MainWindow::drawCircleMidpoint);
     connect(btnCart,  &QPushButton::clicked, this, &MainWindow::drawCircleCartesian);
+    connect(btnFill,  &QPushButton::clicked, this, &MainWindow::drawFilledCircle);
+    connect(btnAA,    &QPushButton::clicked, this, &MainWindow::drawCircleAntialiased);
+    connect(btnFillAA, &QPushButton::clicked, this, &MainWindow::drawFilledCircleAntialiased);
+    connect(btnArc,   &QPushButton::clicked, this, &MainWindow::drawArc);
+    connect(btnThick, &QPushButton::clicked, this, &MainWindow::drawThickCircle);
+    connect(btnRings, &QPushButton::clicked, this, &MainWindow::drawConcentricCircles);
+    connect(btnGrid,  &QPushButton::clicked, this, &MainWindow::drawCircleGrid);
     connect(btnPerf,  &QPushButton::clicked, this, &MainWindow::compareExecutionTimes);
+    connect(btnSweep, &QPushButton::clicked, this, &MainWindow::sweepSizes);
     connect(btnClear, &QPushButton::clicked, scene, &GridScene::clearCells);
     connect(radiusSlider, &QSlider::valueChanged, this, &MainWindow::onRadiusSliderChanged);
 
@@ -101,12 +177,20 @@ void MainWindow::onRadiusSliderChanged(int value)
     setStatus(QString("Radius: %1").arg(value));
 }
 
+// The outline and the centre cell are the scene's live overlay: only cells that differ from the
+// previous tick are repainted, and the next drawing commits the overlay beneath itself.
 void MainWindow::drawCircleImmediate(int r, const QBrush& brush)
 {
-    scene->clearCells();
-    scene->paintCell(centerCell, QBrush(Qt::blue));
-    const auto pts = buildMidpointFrames(centerCell, r);
-    for (const QPoint& p : pts) scene->paintCell(p, brush);
+    QHash<QPoint, QBrush> next;
+    next.insert(centerCell, QBrush(Qt::blue));
+    auto add = [&](int x, int y) { next.insert(QPoint(x, y), brush); };
+    if (clipCheck->isChecked()) {
+        CircleKernel::visibleMidpoint(centerCell, r, visibleCells(), add);
+    } else {
+        next.reserve(CircleKernel::midpointCapacity(r) + 1);
+        CircleKernel::midpoint(centerCell, r, add);
+    }
+    scene->setLiveCells(next);
 }
 
 void MainWindow::setStatus(const QString& s) { statusBar()->showMessage(s, 5000); }
@@ -137,6 +221,92 @@ int MainWindow::currentRadius() const {
     return text.toInt();
 }
 
+// The buffer is sized once from the generator's bound and written through a raw pointer;
+// per-point append() pays a capacity and detach check on every one of the eight writes.
+QVector<QPoint> MainWindow::buildPolarFrames(const QPoint& c, int r) {
+    QVector<QPoint> frames(CircleKernel::polarCapacity(r));
+    QPoint *out = frames.data();
+    CircleKernel::polar(c, r, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+QVector<QPoint> MainWindow::buildPolarRecurrenceFrames(const QPoint& c, int r) {
+    QVector<QPoint> frames(CircleKernel::polarCapacity(r));
+    QPoint *out = frames.data();
+    CircleKernel::polarRecurrence(c, r, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+QVector<QPoint> MainWindow::buildMidpointFrames(const QPoint& c, int r) {
+    QVector<QPoint> frames(CircleKernel::midpointCapacity(r));
+    QPoint *out = frames.data();
+    CircleKernel::midpoint(c, r, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+QVector<QPoint> MainWindow::buildCartesianFrames(const QPoint& c, int r) {
+    QVector<QPoint> frames(CircleKernel::cartesianCapacity(r));
+    QPoint *out = frames.data();
+    CircleKernel::cartesian(c, r, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+// The coverage band is two cells wide, about 4 pi r cells, so 16 (r + 1) is room enough
+QVector<QPair<QPoint, qreal>> MainWindow::buildAntialiasedFrames(const QPoint& c, int r) {
+    QVector<QPair<QPoint, qreal>> frames;
+    frames.reserve(16 * (qMax(0, r) + 1));
+    CircleKernel::antialiasedOutline(c, r, [&](int x, int y, double coverage) {
+        frames.append(qMakePair(QPoint(x, y), qreal(coverage)));
+    });
+    return frames;
+}
+
+// Each octant's visible run is monotone in both coordinates, so it has at most w + h cells
+QVector<QPoint> MainWindow::buildVisibleFrames(const QPoint& c, int r, const QRect& view) {
+    const qint64 bound = 8 * (qint64(qMax(0, view.width())) + qMax(0, view.height()));
+    QVector<QPoint> frames(int(qMin<qint64>(CircleKernel::midpointCapacity(r), bound)));
+    QPoint *out = frames.data();
+    CircleKernel::visibleMidpoint(c, r, view, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+QRect MainWindow::visibleCells() const {
+    return scene->cellsIn(view->mapToScene(view->viewport()->rect()).boundingRect());
+}
+
+QVector<QPoint> MainWindow::buildUniqueFrames(Method method, const QPoint& c, int r, int* emitted) {
+    QVector<QPoint> octant;
+    auto collect = [&](int x, int y) { octant.append(QPoint(x, y)); };
+    switch (method) {
+    case Polar:     octant.reserve(CircleKernel::polarCapacity(r) / 8);     CircleKernel::polarOctant(r, collect);     break;
+    case PolarRecurrence:
+        octant.reserve(CircleKernel::polarCapacity(r) / 8);
+        CircleKernel::polarRecurrenceOctant(r, collect);
+        break;
+    case Midpoint:  octant.reserve(CircleKernel::midpointCapacity(r) / 8);  CircleKernel::midpointOctant(r, collect);  break;
+    case Cartesian: octant.reserve(CircleKernel::cartesianCapacity(r) / 8); CircleKernel::cartesianOctant(r, collect); break;
+    }
+    if (emitted) *emitted = 8 * octant.size();
+
+    QVector<QPoint> frames(8 * octant.size());
+    QPoint *out = frames.data();
+    CircleKernel::traceOctants(octant, c, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
+    return frames;
+}
+
+void MainWindow::reportOverdraw(const QString& method, int emitted, int unique) {
+    const double ratio = unique > 0 ? double(emitted) / unique : 0.0;
+    qDebug() << "Pixels emitted vs unique (" + method + " Method):" << emitted << "/" << unique
+             << QString("(%1x)").arg(ratio, 0, 'f', 2);
+    setStatus(QString("%1: %2 pixels emitted, %3 unique (%4x)").arg(method).arg(emitted).arg(unique).arg(ratio, 0, 'f', 2));
+}
+
 QVector<QPoint> MainWindow::eightSymmetry(const QPoint& c, int x, int y) {
     return {
         {c.x() + x, c.y() + y},
@@ -150,7 +320,7 @@ QVector<QPoint> MainWindow::eightSymmetry(const QPoint& c, int x, int y) {
     };
 }
 
-QVector<QPoint> MainWindow::buildPolarFrames(const QPoint& c, int r) {
+QVector<QPoint> MainWindow::buildPolarFramesBaseline(const QPoint& c, int r) {
     QVector<QPoint> frames;
     const double dtheta = 1.0 / qMax(1, r);
     for (double t = 0.0; t <= M_PI/4.0 + 1e-9; t += dtheta) {
@@ -161,7 +331,7 @@ QVector<QPoint> MainWindow::buildPolarFrames(const QPoint& c, int r) {
     return frames;
 }
 
-QVector<QPoint> MainWindow::buildMidpointFrames(const QPoint& c, int r) {
+QVector<QPoint> MainWindow::buildMidpointFramesBaseline(const QPoint& c, int r) {
     QVector<QPoint> frames;
     int x = 0, y = r, p = 1 - r;
     while (x <= y) {
@@ -173,10 +343,10 @@ QVector<QPoint> MainWindow::buildMidpointFrames(const QPoint& c, int r) {
     return frames;
 }
 
-QVector<QPoint> MainWindow::buildCartesianFrames(const QPoint& c, int r) {
+QVector<QPoint> MainWindow::buildCartesianFramesBaseline(const QPoint& c, int r) {
     QVector<QPoint> frames;
     for (int x = 0; x <= r; ++x) {
-        const int y = int(qRound(qSqrt(double(r*r - x*x))));
+        const int y = int(qRound(qSqrt(double(r) * r - double(x) * x)));
         frames += eightSymmetry(c, x, y);
     }
     return frames;
@@ -200,33 +370,302 @@ void MainWindow::stepAnimation() {
 
 void MainWindow::drawCirclePolar() {
     const int r = currentRadius();
-    auto frames = buildPolarFrames(centerCell, r);
-    qDebug() << "Number of pixels coloured (Polar Method):" << frames.size();
+    int emitted = 0;
+    auto frames = buildUniqueFrames(Polar, centerCell, r, &emitted);
+    reportOverdraw("Polar", emitted, frames.size());
     beginAnimation(frames, kPolarBrush, 15);
 }
 
+void MainWindow::drawCirclePolarRecurrence() {
+    const int r = currentRadius();
+    int emitted = 0;
+    auto frames = buildUniqueFrames(PolarRecurrence, centerCell, r, &emitted);
+    reportOverdraw("Polar (no trig)", emitted, frames.size());
+    beginAnimation(frames, kPolarRecurrenceBrush, 15);
+}
+
 void MainWindow::drawCircleMidpoint() {
     const int r = currentRadius();
-    auto frames = buildMidpointFrames(centerCell, r);
-    qDebug() << "Number of pixels coloured (Midpoint Method):" << frames.size();
+    if (clipCheck->isChecked()) {
+        const QRect visible = visibleCells();
+        const QVector<QPoint> frames = buildVisibleFrames(centerCell, r, visible);
+        qDebug() << "Midpoint clipped to" << visible << ":" << frames.size() << "cells generated";
+        setStatus(QString("Midpoint, clipped to view: %1 cells generated").arg(frames.size()));
+        beginAnimation(frames, kMidBrush, 10);
+        return;
+    }
+    int emitted = 0;
+    auto frames = buildUniqueFrames(Midpoint, centerCell, r, &emitted);
+    reportOverdraw("Midpoint", emitted, frames.size());
     beginAnimation(frames, kMidBrush, 10);
 }
 
 void MainWindow::drawCircleCartesian() {
     const int r = currentRadius();
-    auto frames = buildCartesianFrames(centerCell, r);
-    qDebug() << "Number of pixels coloured (Cartesian Method):" << frames.size();
+    int emitted = 0;
+    auto frames = buildUniqueFrames(Cartesian, centerCell, r, &emitted);
+    reportOverdraw("Cartesian", emitted, frames.size());
     beginAnimation(frames, QBrush(QColor(10, 160, 10)), 12);
 }
 
+// One span per row straight into the scene, instead of a flood fill over every interior cell
+void MainWindow::drawFilledCircle() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    animTimer.stop();
+    int spans = 0;
+    CircleKernel::filledMidpoint(centerCell, currentRadius(), [&](int y, int x0, int x1) {
+        scene->paintSpan(y, x0, x1, kFillBrush);
+        ++spans;
+    });
+    scene->paintCell(centerCell, QBrush(Qt::blue));
+    setStatus(QString("Filled disk: %1 span writes").arg(spans));
+}
+
+// Coverage is composited over the scene, so drawing over other shapes blends with them
+void MainWindow::drawCircleAntialiased() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    animTimer.stop();
+    const QVector<QPair<QPoint, qreal>> cells = buildAntialiasedFrames(centerCell, currentRadius());
+    scene->blendCells(cells, kMidBrush.color());
+    setStatus(QString("Anti-aliased outline: %1 cells").arg(cells.size()));
+}
+
+// Solid runs go in as spans, like drawFilledCircle; only the edge cells are blended
+void MainWindow::drawFilledCircleAntialiased() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    animTimer.stop();
+    const int r = currentRadius();
+    QVector<QPair<QPoint, qreal>> edge;
+    edge.reserve(16 * (r + 1));
+    int spans = 0;
+    CircleKernel::antialiasedDisk(centerCell, r,
+        [&](int y, int x0, int x1) { scene->paintSpan(y, x0, x1, kFillBrush); ++spans; },
+        [&](int x, int y, double coverage) { edge.append(qMakePair(QPoint(x, y), qreal(coverage))); });
+    scene->blendCells(edge, kFillBrush.color());
+    setStatus(QString("Anti-aliased disk: %1 span writes, %2 edge cells").arg(spans).arg(edge.size()));
+}
+
+// A stroke of the given thickness centred on the radius: the ring between the midpoint circles
+// at its inner and outer edges, painted as at most two spans per row
+void MainWindow::drawThickCircle() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    animTimer.stop();
+    const int t = thicknessInput->value();
+    const int outer = currentRadius() + t / 2;
+    const int inner = qMax(0, outer - t + 1);
+    int spans = 0;
+    qint64 cells = 0;
+    CircleKernel::annulus(centerCell, inner, outer, [&](int y, int x0, int x1) {
+        scene->paintSpan(y, x0, x1, kMidBrush);
+        ++spans;
+        cells += x1 - x0 + 1;
+    });
+    setStatus(QString("Ring %1..%2: %3 cells in %4 span writes").arg(inner).arg(outer).arg(cells).arg(spans));
+}
+
+// Rasterise the whole batch across threads, then hand it to the scene in one paintCells call
+void MainWindow::paintBatch(const QString& name, const QVector<CircleBatch::Job>& jobs) {
+    animTimer.stop();
+    QElapsedTimer t;
+    t.start();
+    const QVector<QPoint> cells = CircleBatch::outlines(jobs);
+    const qint64 rasterNs = t.nsecsElapsed();
+    scene->paintCells(cells, kMidBrush);
+    const qint64 totalNs = t.nsecsElapsed();
+    setStatus(QString("%1: %2 circles, %3 cells, rasterised in %4 us, committed in %5 us")
+                  .arg(name).arg(jobs.size()).arg(cells.size())
+                  .arg(rasterNs / 1000).arg((totalNs - rasterNs) / 1000));
+}
+
+// Every radius from 1 to the current one around the selected centre
+void MainWindow::drawConcentricCircles() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    paintBatch("Concentric", CircleBatch::concentric(centerCell, currentRadius()));
+}
+
+// A 10 x 10 grid of circles of the current radius, starting at the selected centre
+void MainWindow::drawCircleGrid() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    const int r = currentRadius();
+    paintBatch("Grid", CircleBatch::grid(centerCell, 10, 10, 2 * r + 3, r));
+}
+
+// Only the octant columns the arc covers are stepped. Chords and radii join the arc's end
+// cells, and the set keeps the cells where they meet the arc from being painted twice.
+void MainWindow::drawArc() {
+    if (!haveCenter) { setStatus("Please select a center point first!"); return; }
+    if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
+    animTimer.stop();
+    const int r = currentRadius();
+    const double start = arcStartInput->value(), sweep = arcSweepInput->value();
+    const int mode = arcModeBox->currentIndex();
+
+    if (mode == FilledSector) {
+        int spans = 0;
+        CircleKernel::filledSector(centerCell, r, start, sweep, [&](int y, int x0, int x1) {
+            scene->paintSpan(y, x0, x1, kFillBrush);
+            ++spans;
+        });
+        setStatus(QString("Filled sector: %1 span writes").arg(spans));
+        return;
+    }
+
+    QSet<QPoint> cells;
+    auto add = [&](int x, int y) { cells.insert(QPoint(x, y)); };
+    CircleKernel::arc(centerCell, r, start, sweep, add);
+    if (sweep < 360.0) {
+        const QPoint from = CircleKernel::arcPoint(centerCell, r, start);
+        const QPoint to = CircleKernel::arcPoint(centerCell, r, start + sweep);
+        if (mode == Chord) {
+            LineKernel::bresenham(from, to, add);
+        } else if (mode == Sector) {
+            LineKernel::bresenham(centerCell, from, add);
+            LineKernel::bresenham(centerCell, to, add);
+        }
+    }
+    for (const QPoint& p : cells) scene->paintCell(p, kArcBrush);
+    setStatus(QString("%1: %2 cells").arg(arcModeBox->currentText()).arg(cells.size()));
+}
+
 void MainWindow::compareExecutionTimes() {
     if (!haveCenter) { setStatus("Please select a center point first!"); return; }
     if (radiusInput->text().isEmpty()) { setStatus("Please enter a radius value!"); return; }
     const int r = currentRadius();
     const int iters = 200;
-    QElapsedTimer t; qint64 tp=0, tm=0, tc=0;
-    t.start(); for (int i=0;i<iters;++i) volatile auto v = buildPolarFrames(centerCell, r); tp = t.nsecsElapsed();
-    t.restart(); for (int i=0;i<iters;++i) volatile auto v = buildMidpointFrames(centerCell, r); tm = t.nsecsElapsed();
-    t.restart(); for (int i=0;i<iters;++i) volatile auto v = buildCartesianFrames(centerCell, r); tc = t.nsecsElapsed();
-    setStatus(QString("Avg per iteration (ns): Polar %1 | Midpoint %2 | Cartesian %3").arg(tp/iters).arg(tm/iters).arg(tc/iters));
+    QElapsedTimer t;
+    auto avg = [&](QVector<QPoint> (MainWindow::*build)(const QPoint&, int)) {
+        t.start();
+        for (int i = 0; i < iters; ++i) volatile auto v = (this->*build)(centerCell, r);
+        return t.nsecsElapsed() / iters;
+    };
+    const qint64 tpBase = avg(&MainWindow::buildPolarFramesBaseline),    tp = avg(&MainWindow::buildPolarFrames);
+    const qint64 tmBase = avg(&MainWindow::buildMidpointFramesBaseline),  tm = avg(&MainWindow::buildMidpointFrames);
+    const qint64 tcBase = avg(&MainWindow::buildCartesianFramesBaseline), tc = avg(&MainWindow::buildCartesianFrames);
+    const qint64 tpRec = avg(&MainWindow::buildPolarRecurrenceFrames);
+    qDebug() << "Avg ns, eightSymmetry baseline -> direct sink:"
+             << "Polar" << tpBase << "->" << tp
+             << "| Midpoint" << tmBase << "->" << tm
+             << "| Cartesian" << tcBase << "->" << tc;
+    const QVector<QPoint> trig = buildPolarFrames(centerCell, r), rec = buildPolarRecurrenceFrames(centerCell, r);
+    int differing = qAbs(trig.size() - rec.size());
+    for (int i = 0; i < qMin(trig.size(), rec.size()); ++i)
+        if (trig[i] != rec[i]) ++differing;
+    qDebug() << "Avg ns, polar without trig:" << tpRec << "| cells differing from trig polar:" << differing;
+    const char* names[] = { "Polar", "Polar (no trig)", "Midpoint", "Cartesian" };
+    for (Method m : { Polar, PolarRecurrence, Midpoint, Cartesian }) {
+        int emitted = 0;
+        const int unique = buildUniqueFrames(m, centerCell, r, &emitted).size();
+        qDebug() << "Pixels emitted vs unique (" + QString(names[m]) + " Method):" << emitted << "/" << unique;
+    }
+    const QVector<CircleBatch::Job> rings = CircleBatch::concentric(centerCell, r);
+    t.start();
+    const int batchCells = CircleBatch::outlines(rings, false).size();
+    const qint64 tSerial = t.nsecsElapsed();
+    t.start();
+    CircleBatch::outlines(rings, true);
+    const qint64 tParallel = t.nsecsElapsed();
+    qDebug() << "Concentric batch of" << rings.size() << "circles," << batchCells << "cells, ns serial / threaded:"
+             << tSerial << "/" << tParallel;
+    setStatus(QString("Avg per iteration (ns), baseline -> direct: Polar %1 -> %2 (no trig %7) | Midpoint %3 -> %4 | Cartesian %5 -> %6")
+                  .arg(tpBase).arg(tp).arg(tmBase).arg(tm).arg(tcBase).arg(tc).arg(tpRec));
+}
+
+// Radii 1..10^5 on a log scale. Midpoint goes first, so the pixel counts every method is
+// normalised by are the distinct cells of the midpoint circle.
+void MainWindow::sweepSizes() {
+    animTimer.stop();
+    const QPoint origin(0, 0);
+    SweepBenchmark bench;
+    bench.addAlgorithm("Midpoint", [this, origin](int r) { return buildMidpointFrames(origin, r); });
+    bench.addAlgorithm("Polar", [this, origin](int r) { return buildPolarFrames(origin, r); });
+    bench.addAlgorithm("Polar (no trig)", [this, origin](int r) { return buildPolarRecurrenceFrames(origin, r); });
+    bench.addAlgorithm("Cartesian", [this, origin](int r) { return buildCartesianFrames(origin, r); });
+    bench.addAlgorithm("Anti-aliased", [origin](int r) {
+        QVector<QPoint> cells;
+        cells.reserve(16 * (r + 1));
+        CircleKernel::antialiasedOutline(origin, r, [&](int x, int y, double coverage) {
+            if (coverage > 0.0) cells.append(QPoint(x, y));   // keeps the coverage computed
+        });
+        return cells;
+    });
+    bench.addAlgorithm("Midpoint (per-step vectors)", [this, origin](int r) { return buildMidpointFramesBaseline(origin, r); });
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const QVector<SweepBenchmark::Row> rows = bench.run();
+    QApplication::restoreOverrideCursor();
+
+    for (const SweepBenchmark::Row& row : rows) {
+        qDebug() << "Radius" << row.size << "pixels" << row.pixels;
+        for (int a = 0; a < row.nsPerPixel.size(); ++a)
+            qDebug() << "   " << bench.algorithmNames().at(a) << row.nsPerPixel[a].mean << "+/-" << row.nsPerPixel[a].ci95
+                     << "ns/pixel," << row.allocations[a] << "allocations";
+    }
+
+    showSweep(bench, rows);
+}
+
+void MainWindow::showSweep(const SweepBenchmark& bench, const QVector<SweepBenchmark::Row>& rows) {
+    const QStringList names = bench.algorithmNames();
+
+    QStringList headers = { "Radius", "Pixels" };
+    for (const QString& name : names)
+        headers << name + " ns/px" << name + " allocs";
+
+    QTableWidget *table = new QTableWidget(rows.size(), headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    for (int r = 0; r < rows.size(); ++r) {
+        const SweepBenchmark::Row& row = rows[r];
+        int c = 0;
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.size)));
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.pixels)));
+        for (int a = 0; a < row.nsPerPixel.size(); ++a) {
+            const SweepBenchmark::Stat& s = row.nsPerPixel[a];
+            table->setItem(r, c++, new QTableWidgetItem(QString("%1 +/- %2").arg(s.mean, 0, 'f', 3).arg(s.ci95, 0, 'f', 3)));
+            table->setItem(r, c++, new QTableWidgetItem(row.allocations[a] < 0 ? QString("n/a") : QString::number(row.allocations[a])));
+        }
+    }
+    table->resizeColumnsToContents();
+
+    SweepPlot *plot = new SweepPlot;
+    plot->setResults(names, rows);
+
+    QString pinned = bench.pinnedCpu() >= 0 ? QString("pinned to CPU %1").arg(bench.pinnedCpu()) : QString("not pinned");
+    QLabel *summary = new QLabel(QString("Circle outlines by radius, mean +/- 95% confidence interval over %1 timed "
+                                         "repetitions after warm-up; thread %2. Allocations are heap calls per circle%3.")
+                                     .arg(bench.repetitions()).arg(pinned)
+                                     .arg(SweepBenchmark::countsAllocations() ? "" : " (not counted in this build)"));
+    summary->setWordWrap(true);
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Circle radius sweep");
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    QPushButton *btnCsv = buttons->addButton("Export CSV...", QDialogButtonBox::ActionRole);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(btnCsv, &QPushButton::clicked, &dialog, [&] {
+        const QString path = QFileDialog::getSaveFileName(&dialog, "Export CSV", "circle-sweep.csv", "CSV files (*.csv)");
+        if (path.isEmpty()) return;
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            setStatus(QString("Could not write %1").arg(path));
+            return;
+        }
+        file.write(bench.toCsv(rows).toUtf8());
+        setStatus(QString("Sweep written to %1").arg(path));
+    });
+
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    layout->addWidget(summary);
+    layout->addWidget(plot, 3);
+    layout->addWidget(table, 2);
+    layout->addWidget(buttons);
+    dialog.resize(1000, 720);
+    dialog.exec();
 }
@@ -1,14 +1,21 @@
 #pragma once
 #include <QMainWindow>
 #include <QPoint>
+#include <QRect>
 #include <QVector>
+#include <QPair>
 #include <QBrush>
 #include <QTimer>
+#include "circlebatch.h"
+#include "sweepbench.h"
 
 class GridScene;
 class GridView;
 class QLineEdit;
 class QSlider;
+class QSpinBox;
+class QComboBox;
+class QCheckBox;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -21,28 +28,63 @@ private slots:
     void onRadiusChanged();
     void onRadiusSliderChanged(int value);
     void drawCirclePolar();
+    void drawCirclePolarRecurrence();
     void drawCircleMidpoint();
     void drawCircleCartesian();
+    void drawFilledCircle();
+    void drawCircleAntialiased();
+    void drawFilledCircleAntialiased();
+    void drawArc();
+    void drawThickCircle();
+    void drawConcentricCircles();
+    void drawCircleGrid();
     void compareExecutionTimes();
+    void sweepSizes();
     void stepAnimation();
 
 private:
+    enum Method { Polar, PolarRecurrence, Midpoint, Cartesian };
+    enum ArcMode { ArcOnly, Chord, Sector, FilledSector };
+
     void setStatus(const QString& s);
     int  currentRadius() const;
 
-    QVector<QPoint> eightSymmetry(const QPoint& c, int x, int y);
     QVector<QPoint> buildPolarFrames(const QPoint& c, int r);
+    QVector<QPoint> buildPolarRecurrenceFrames(const QPoint& c, int r);
     QVector<QPoint> buildMidpointFrames(const QPoint& c, int r);
     QVector<QPoint> buildCartesianFrames(const QPoint& c, int r);
+    // Midpoint cells inside `view` only; work and memory follow the visible perimeter
+    QVector<QPoint> buildVisibleFrames(const QPoint& c, int r, const QRect& view);
+    QRect visibleCells() const;
+    QVector<QPair<QPoint, qreal>> buildAntialiasedFrames(const QPoint& c, int r);
+
+    // Each cell of the method's circle once, in angular order. `emitted` receives how many
+    // points the eight-way builders above produce for the same radius.
+    QVector<QPoint> buildUniqueFrames(Method method, const QPoint& c, int r, int* emitted = nullptr);
+    void reportOverdraw(const QString& method, int emitted, int unique);
+
+    // Container-per-step versions, kept as the baseline for compareExecutionTimes
+    QVector<QPoint> eightSymmetry(const QPoint& c, int x, int y);
+    QVector<QPoint> buildPolarFramesBaseline(const QPoint& c, int r);
+    QVector<QPoint> buildMidpointFramesBaseline(const QPoint& c, int r);
+    QVector<QPoint> buildCartesianFramesBaseline(const QPoint& c, int r);
+
+    void showSweep(const SweepBenchmark& bench, const QVector<SweepBenchmark::Row>& rows);
 
     void beginAnimation(const QVector<QPoint>& frames, const QBrush& brush, int msStep);
     void drawCircleImmediate(int r, const QBrush& brush);
+    void paintBatch(const QString& name, const QVector<CircleBatch::Job>& jobs);
 
     GridScene* scene{nullptr};
     GridView*  view{nullptr};
 
     QLineEdit* radiusInput{nullptr};
     QSlider*   radiusSlider{nullptr};
+    QSpinBox*  thicknessInput{nullptr};
+    QSpinBox*  arcStartInput{nullptr};
+    QSpinBox*  arcSweepInput{nullptr};
+    QComboBox* arcModeBox{nullptr};
+    QCheckBox* clipCheck{nullptr};
 
     QPoint centerCell{0,0};
     bool   haveCenter{false};
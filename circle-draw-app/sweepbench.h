@@ -0,0 +1,53 @@
+#ifndef SWEEPBENCH_H
+#define SWEEPBENCH_H
+
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+// Times shape rasterisers over sizes from 1 to 10^5 on a log scale, to show how each
+// method's cost grows and where the curves cross. Results are ns per pixel with a 95%
+// confidence interval over repeated timed runs, and heap allocations per shape.
+class SweepBenchmark {
+public:
+    using ShapeFn = std::function<QVector<QPoint>(int size)>;
+
+    struct Stat {
+        double mean = 0;    // ns per pixel
+        double ci95 = 0;    // half-width of the 95% confidence interval
+    };
+
+    struct Row {
+        int size = 0;
+        qint64 pixels = 0;              // distinct cells drawn by the first algorithm
+        QVector<Stat> nsPerPixel;       // one per algorithm, in the order they were added
+        QVector<qint64> allocations;    // heap allocator calls per shape, -1 when not counted
+    };
+
+    void addAlgorithm(const QString& name, ShapeFn fn);
+
+    // One row per size: 1, then `stepsPerDecade` log-spaced sizes per decade up to maxSize
+    QVector<Row> run(int maxSize = 100000, int stepsPerDecade = 4, int repetitions = 7);
+
+    // "size,pixels" then "<name> ns/px,<name> ci95,<name> allocs" per algorithm
+    QString toCsv(const QVector<Row>& rows) const;
+
+    QStringList algorithmNames() const;
+    int pinnedCpu() const { return cpu; }   // -1 when the thread could not be pinned
+    int repetitions() const { return reps; }
+    static bool countsAllocations();        // false unless built with CONFIG+=sweep_alloc_count on glibc
+
+private:
+    struct Algorithm {
+        QString name;
+        ShapeFn fn;
+    };
+
+    QVector<Algorithm> algorithms;
+    int cpu = -1;
+    int reps = 0;
+};
+
+#endif // SWEEPBENCH_H
@@ -0,0 +1,24 @@
+#ifndef SWEEPPLOT_H
+#define SWEEPPLOT_H
+
+#include <QStringList>
+#include <QVector>
+#include <QWidget>
+#include "sweepbench.h"
+
+// Log-log plot of ns per pixel against shape size, one curve per algorithm
+class SweepPlot : public QWidget {
+public:
+    explicit SweepPlot(QWidget* parent = nullptr);
+
+    void setResults(const QStringList& algorithmNames, const QVector<SweepBenchmark::Row>& results);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QStringList names;
+    QVector<SweepBenchmark::Row> rows;
+};
+
+#endif // SWEEPPLOT_H
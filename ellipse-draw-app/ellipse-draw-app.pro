@@ -12,16 +12,24 @@ SOURCES += \
     gridscene.cpp \
     gridview.cpp \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    sweepbench.cpp \
+    sweepplot.cpp
 
 HEADERS += \
     gridscene.h \
     gridview.h \
-    mainwindow.h
+    ellipsekernel.h \
+    mainwindow.h \
+    sweepbench.h \
+    sweepplot.h
 
 FORMS += \
     mainwindow.ui
 
+# Benchmark builds only: count heap allocations in the size sweep by replacing malloc
+sweep_alloc_count: DEFINES += SWEEP_COUNT_ALLOCATIONS
+
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
@@ -0,0 +1,325 @@
+#ifndef ELLIPSEKERNEL_H
+#define ELLIPSEKERNEL_H
+
+#include <QPoint>
+#include <QVector>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Ellipse generators that pass each first-quadrant sample (x, y), before mirroring, to a
+// plot(x, y) callback. They visit the same samples as MainWindow::buildPolarFrames and
+// buildMidpointFrames.
+namespace EllipseKernel {
+
+template <typename Plot>
+void polarQuadrant(int a, int b, Plot&& plot)
+{
+    const double dtheta = 1.0 / (a + b);
+    for (double theta = 0.0; theta <= M_PI/2.0 + 1e-9; theta += dtheta)
+        plot(int(qRound(a * qCos(theta))), int(qRound(b * qSin(theta))));
+}
+
+// Same angles as polarQuadrant, but (cos t, sin t) is advanced by a fixed rotation instead of
+// calling qCos/qSin each step. Every 32 steps the vector is pulled back to unit length
+// (one Newton step towards 1/|v|, no sqrt), so the drift stays at rounding-error level.
+template <typename Plot>
+void polarRecurrenceQuadrant(int a, int b, Plot&& plot)
+{
+    const double dtheta = 1.0 / (a + b);
+    const double cd = qCos(dtheta), sd = qSin(dtheta);
+    double cs = 1.0, sn = 0.0;
+    int step = 0;
+    for (double theta = 0.0; theta <= M_PI/2.0 + 1e-9; theta += dtheta) {
+        plot(int(qRound(a * cs)), int(qRound(b * sn)));
+        const double c2 = cs * cd - sn * sd;
+        sn = sn * cd + cs * sd;
+        cs = c2;
+        if ((++step & 31) == 0) {
+            const double k = 0.5 * (3.0 - (cs * cs + sn * sn));
+            cs *= k;
+            sn *= k;
+        }
+    }
+}
+
+// Integer-only midpoint ellipse. px = 2b^2 x and py = 2a^2 y are stepped by 2b^2 and 2a^2,
+// so the loops have no multiplies. d is the midpoint value of F = b^2 x^2 + a^2 y^2 - a^2 b^2
+// less its fractional part, which is a^2/4 mod 1 in region 1 and b^2/4 mod 1 in region 2.
+// That part is 0 or 1/4, so d < 0 exactly when the real midpoint test is negative. Region 2
+// is seeded from region 1 by the exact difference of the two midpoints, so nothing of order
+// a^2 b^2 is ever formed. Every value stays inside qint64 for semi-axes up to 10^6.
+// plot(x, y) gets each first-quadrant sample. row(x, y) gets each row y once, with its
+// widest x.
+template <typename Plot, typename Row>
+void midpointWalk(int a, int b, Plot&& plot, Row&& row)
+{
+    const qint64 a2 = qint64(a) * a, b2 = qint64(b) * b;
+    const qint64 twoA2 = 2 * a2, twoB2 = 2 * b2;
+    qint64 x = 0, y = b, px = 0, py = twoA2 * y;
+    qint64 d = b2 - a2 * b + (a2 >> 2);
+
+    while (px <= py) {
+        plot(int(x), int(y));
+        ++x; px += twoB2;
+        if (d < 0) d += b2 + px;
+        else { row(int(x - 1), int(y)); --y; py -= twoA2; d += b2 + px - py; }
+    }
+
+    d += (3 * a2 + (a2 & 3) - 3 * b2 - (b2 & 3)) / 4 - b2 * x - a2 * y;
+    while (y >= 0) {
+        plot(int(x), int(y));
+        row(int(x), int(y));
+        --y; py -= twoA2;
+        if (d < 0) { ++x; px += twoB2; d += px - py + a2; }
+        else d += a2 - py;
+    }
+}
+
+template <typename Plot>
+void midpointQuadrant(int a, int b, Plot&& plot)
+{
+    midpointWalk(a, b, plot, [](int, int) {});
+}
+
+// Filled ellipse as one span(y, x0, x1) per row, 2b + 1 in all. In region 1 a row is emitted
+// when y is about to drop, because that x is the widest the row gets. Region 2 visits every
+// row once.
+template <typename Span>
+void filledMidpoint(const QPoint& c, int a, int b, Span&& span)
+{
+    midpointWalk(a, b, [](int, int) {}, [&](int x, int y) {
+        span(c.y() + y, c.x() - x, c.x() + x);
+        if (y != 0) span(c.y() - y, c.x() - x, c.x() + x);
+    });
+}
+
+// Signed Euclidean distance from (x, y) to the ellipse with semi-axes a, b, negative inside.
+// Eberly's formulation: in the first quadrant with e0 >= e1 and z = (x / e0, y / e1), the
+// closest point is (r0 x / (s + r0), y / (s + 1)) with r0 = (e0 / e1)^2, where s is the root of
+// G(s) = (r0 z0 / (s + r0))^2 + (z1 / (s + 1))^2 - 1. G is convex and falls for s > -1, so
+// Newton steps kept at or above z1 - 1 (where G >= 0) converge from either side of the root.
+// They start from *root when it holds a guess, and otherwise from the first-order projection
+// p - F grad F / |grad F|^2. The root found is written back to *root and ds/d|x| to *slope,
+// so a caller stepping along a row can predict the next cell's root. The first-order distance
+// F / |grad F| alone goes badly wrong near the tips of thin ellipses, where the curvature is
+// high.
+inline double signedDistance(double a, double b, double x, double y,
+                             double* root = nullptr, double* slope = nullptr)
+{
+    double e0 = a, e1 = b, y0 = qAbs(x), y1 = qAbs(y);
+    const bool swapped = e0 < e1;
+    if (swapped) {
+        std::swap(e0, e1);
+        std::swap(y0, y1);
+    }
+    const double z0 = y0 / e0, z1 = y1 / e1;
+    const double sign = z0 * z0 + z1 * z1 < 1.0 ? -1.0 : 1.0;
+
+    if (y1 == 0.0) {
+        // on the major axis the closest point leaves the axis once the point is inside the
+        // centre of curvature of the tip
+        const double numer = e0 * y0, denom = e0 * e0 - e1 * e1;
+        if (numer >= denom) return sign * qAbs(y0 - e0);
+        const double xe = numer / denom;
+        return sign * std::hypot(e0 * xe - y0, e1 * std::sqrt(1.0 - xe * xe));
+    }
+    if (y0 == 0.0) return sign * qAbs(y1 - e1);
+
+    const double r0 = (e0 / e1) * (e0 / e1), n0 = r0 * z0;
+    const double lo = z1 - 1.0;
+    double s = lo;
+    if (root && std::isfinite(*root)) {
+        s = qMax(lo, *root);
+    } else {
+        const double gx = y0 / (e0 * e0), gy = y1 / (e1 * e1);
+        const double q1 = y1 - (z0 * z0 + z1 * z1 - 1.0) / (2.0 * (gx * gx + gy * gy)) * gy;
+        if (q1 > 0.0) s = qMax(lo, y1 / q1 - 1.0);
+    }
+    for (int i = 0; i < 64; ++i) {
+        const double u0 = s + r0, u1 = s + 1.0, w0 = n0 / u0, w1 = z1 / u1;
+        const double g = w0 * w0 + w1 * w1 - 1.0;
+        const double dg = -2.0 * (w0 * w0 / u0 + w1 * w1 / u1);
+        const double next = qMax(lo, s - g / dg);
+        // convergence is quadratic, so a step this small leaves an error near its square
+        const bool done = qAbs(next - s) <= 1e-7 * (1.0 + qAbs(next));
+        s = next;
+        if (done) break;
+    }
+    if (root) *root = s;
+    if (slope) {
+        // ds/d|x| from G(s, z0, z1) = 0, for predicting the root at the next cell of the row
+        const double u0 = s + r0, u1 = s + 1.0, w0 = n0 / u0, w1 = z1 / u1;
+        const double dgds = -2.0 * (w0 * w0 / u0 + w1 * w1 / u1);
+        const double dgdx = swapped ? 2.0 * w1 / (u1 * e1) : 2.0 * w0 * r0 / (u0 * e0);
+        *slope = -dgdx / dgds;
+    }
+    return sign * std::hypot(r0 * y0 / (s + r0) - y0, y1 / (s + 1.0) - y1);
+}
+
+// Anti-aliased ellipses. Each row |y| <= rows is walked inwards with the exact signed distance
+// d, starting from the largest x with d <= t, where t is the widest band the caller needs.
+// The first-order estimate F / |grad F|, with F = b^2 x^2 + a^2 y^2 - a^2 b^2, never exceeds
+// d outside the ellipse. So the x where it equals t (a quadratic in x^2, one sqrt), capped
+// at a + t, bounds the band. visit(x, y, d) gets each x >= 0 and returns false to end the
+// row. The signed distance to a convex curve is convex along the row and even in x, so d
+// falls monotonically as x falls. Each cell's root-find starts from the previous cell's root
+// moved along its tangent, which one or two Newton steps then correct.
+template <typename Visit>
+void distanceRows(double a, double b, int rows, double t, Visit&& visit)
+{
+    const double a2 = a * a, b2 = b * b, a4 = a2 * a2, b4 = b2 * b2;
+    const qint64 xmax = qint64(std::floor(a + t));
+    for (int y = -rows; y <= rows; ++y) {
+        const double yy = double(y) * y;
+        const double k = a2 * (yy - b2) / b2;
+        const double u = 2 * t * t - k + 2 * t * std::sqrt(qMax(0.0, t * t - k + a4 * yy / b4));
+        qint64 x = u > 0 ? qMin(qint64(std::sqrt(u)) + 1, xmax) : 0;
+        double root = std::numeric_limits<double>::quiet_NaN(), slope = 0.0;
+        for (; x >= 0; --x) {
+            root -= slope;
+            if (!visit(int(x), y, signedDistance(a, b, double(x), double(y), &root, &slope))) break;
+        }
+    }
+}
+
+// One-cell-wide stroke centred on the ellipse. plot(x, y, coverage) gets each cell with
+// coverage 1 - |d| > 0, once.
+template <typename Plot>
+void antialiasedOutline(const QPoint& c, int a, int b, Plot&& plot)
+{
+    if (a < 1 || b < 1) return;
+    distanceRows(a, b, b + 1, 1.0, [&](int x, int y, double d) {
+        if (d <= -1.0) return false;
+        if (d < 1.0) {
+            plot(c.x() + x, c.y() + y, 1.0 - qAbs(d));
+            if (x != 0) plot(c.x() - x, c.y() + y, 1.0 - qAbs(d));
+        }
+        return true;
+    });
+}
+
+// Filled ellipse with its edge half a cell outside the axes, the outer edge of the stroke
+// above. Each row's solid run goes to span(y, x0, x1), and the partly covered cells outside
+// it go to plot(x, y, coverage), where coverage = 1/2 - d.
+template <typename Span, typename Plot>
+void antialiasedFill(const QPoint& c, int a, int b, Span&& span, Plot&& plot)
+{
+    if (a < 1 || b < 1) return;
+    distanceRows(a + 0.5, b + 0.5, b + 1, 0.5, [&](int x, int y, double d) {
+        const double coverage = 0.5 - d;
+        if (coverage >= 1.0) { span(c.y() + y, c.x() - x, c.x() + x); return false; }
+        if (coverage > 0.0) {
+            plot(c.x() + x, c.y() + y, coverage);
+            if (x != 0) plot(c.x() - x, c.y() + y, coverage);
+        }
+        return true;
+    });
+}
+
+// Rows of the ellipse with semi-axes a, b rotated by theta (radians; y points down on screen,
+// so positive is clockwise). Cell (x, y) is inside when A x^2 + B x y + C y^2 <= a^2 b^2, with
+// A = a^2 sin^2 + b^2 cos^2, B = 2 (b^2 - a^2) sin cos and C = a^2 cos^2 + b^2 sin^2. The
+// discriminant for row y reduces to 4 a^2 b^2 (A - y^2). So x = (-B y +- 2ab sqrt(A - y^2)) / 2A,
+// each row costs one sqrt, and the rows run over |y| <= sqrt(A). row(y, x0, x1) is called
+// for every row from the top, with x0 > x1 when no cell centre of the row is inside.
+template <typename Row>
+void rotatedRows(int a, int b, double theta, Row&& row)
+{
+    const double sn = qSin(theta), cs = qCos(theta);
+    const double a2 = double(a) * a, b2 = double(b) * b, ab = double(a) * b;
+    const double A = a2*sn*sn + b2*cs*cs, B = 2.0*(b2 - a2)*sn*cs;
+    const int ymax = int(qFloor(qSqrt(A) + 1e-9));
+    for (int y = -ymax; y <= ymax; ++y) {
+        const double mid = -B * y / (2.0 * A);
+        const double half = ab * qSqrt(qMax(0.0, A - double(y) * y)) / A;
+        row(y, int(qCeil(mid - half - 1e-9)), int(qFloor(mid + half + 1e-9)));
+    }
+}
+
+// Filled rotated ellipse as one span(y, x0, x1) per non-empty row
+template <typename Span>
+void filledRotated(const QPoint& c, int a, int b, double theta, Span&& span)
+{
+    rotatedRows(a, b, theta, [&](int y, int x0, int x1) {
+        if (x0 <= x1) span(c.y() + y, c.x() + x0, c.x() + x1);
+    });
+}
+
+// Outline of the rotated ellipse: the inside cells with a 4-neighbour outside. In row y
+// that is the row minus its interior run. The interior run is the row without its ends,
+// intersected with the rows above and below. So each row gives at most two runs, and no
+// cell is emitted twice.
+template <typename Plot>
+void rotatedOutline(const QPoint& c, int a, int b, double theta, Plot&& plot)
+{
+    QVector<QPoint> rows;   // (x0, x1) per row, top first
+    rows.reserve(2 * qMax(a, b) + 3);
+    int top = 0;
+    rotatedRows(a, b, theta, [&](int y, int x0, int x1) {
+        if (rows.isEmpty()) top = y;
+        rows.append(QPoint(x0, x1));
+    });
+
+    auto empty = [](const QPoint& r) { return r.x() > r.y(); };
+    for (int i = 0; i < rows.size(); ++i) {
+        const QPoint& r = rows[i];
+        if (empty(r)) continue;
+        int lo = r.x() + 1, hi = r.y() - 1;
+        for (int j : { i - 1, i + 1 }) {
+            if (j < 0 || j >= rows.size() || empty(rows[j])) { lo = 1; hi = 0; break; }
+            lo = qMax(lo, rows[j].x());
+            hi = qMin(hi, rows[j].y());
+        }
+        const int y = c.y() + top + i;
+        if (lo > hi) {
+            for (int x = r.x(); x <= r.y(); ++x) plot(c.x() + x, y);
+        } else {
+            for (int x = r.x(); x < lo; ++x) plot(c.x() + x, y);
+            for (int x = hi + 1; x <= r.y(); ++x) plot(c.x() + x, y);
+        }
+    }
+}
+
+// Emit the four-way mirror of `samples` as each cell once, in angular order, starting at
+// (0, b) and heading towards +x. The samples are sorted by angle, repeats are dropped, and
+// the quadrants are walked alternately forwards and backwards. Two quadrants' images only
+// coincide on an axis, so samples with x == 0 or y == 0 are skipped in the quadrant that
+// would repeat them. `samples` is reordered in place. Returns the number of cells emitted.
+template <typename Plot>
+int traceQuadrants(QVector<QPoint>& samples, const QPoint& c, Plot&& plot)
+{
+    for (QPoint& s : samples) s = QPoint(qAbs(s.x()), qAbs(s.y()));
+    auto before = [](const QPoint& p, const QPoint& q) {
+        const qint64 lhs = qint64(p.x()) * q.y(), rhs = qint64(q.x()) * p.y();
+        return lhs != rhs ? lhs < rhs : p.x() + p.y() < q.x() + q.y();
+    };
+    if (!std::is_sorted(samples.begin(), samples.end(), before))
+        std::sort(samples.begin(), samples.end(), before);
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    const int n = samples.size();
+    int emitted = 0;
+    auto put = [&](int x, int y) { plot(c.x() + x, c.y() + y); ++emitted; };
+    for (int q = 0; q < 4; ++q) {
+        const bool forward = (q % 2) == 0;
+        for (int k = 0; k < n; ++k) {
+            const QPoint& s = samples[forward ? k : n - 1 - k];
+            const int x = s.x(), y = s.y();
+            if (q % 2 == 1 && y == 0) continue;     // on the x axis: already emitted
+            if (q >= 2 && x == 0) continue;         // on the y axis: already emitted
+            switch (q) {
+            case 0: put( x,  y); break;
+            case 1: put( x, -y); break;
+            case 2: put(-x, -y); break;
+            default: put(-x,  y); break;
+            }
+        }
+    }
+    return emitted;
+}
+
+} // namespace EllipseKernel
+
+#endif // ELLIPSEKERNEL_H
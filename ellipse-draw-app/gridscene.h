@@ -5,6 +5,7 @@
 #include <QPoint>
 #include <QVector>
 #include <QPair>
+#include <QHash>
 #include <QPainter>
 #include <QBrush>
 
@@ -15,6 +16,14 @@ public:
 
     void toggleCell(const QPoint& cell);
     void paintCell(const QPoint& cell, const QBrush& brush);
+    // Show `cells` as a live overlay above everything else; cells leaving it reveal what is
+    // beneath. The next paint commits the overlay as ordinary cells, so it lands on top.
+    void setLiveCells(const QHash<QPoint, QBrush>& cells);
+    // Fill cells x0..x1 of row y as one entry, drawn as a single rect; it replaces whatever
+    // those cells held, and later cell writes land on top of it
+    void paintSpan(int y, int x0, int x1, const QBrush& brush);
+    // Composite `color` at each cell's coverage (0..1) over what the cell already holds, with one repaint
+    void blendCells(const QVector<QPair<QPoint, qreal>>& cells, const QColor& color);
     void clearCells();
 
 signals:
@@ -23,9 +32,23 @@ signals:
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
     void drawBackground(QPainter* painter, const QRectF& rect) override;
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
 
 private:
+    struct Span {
+        int x0, x1;
+        QBrush brush;
+    };
+
+    void storeCell(const QPoint& cell, const QBrush& brush);
+    void removeCell(const QPoint& cell);
+    void commitLiveCells();
+    void updateCells(QVector<QPoint> cells);
+
     QVector<QPair<QPoint, QBrush>> coloredCells;
+    QHash<QPoint, int> cellIndex;           // position of each cell in coloredCells
+    QHash<int, QVector<Span>> coloredSpans; // disjoint spans of each row
+    QHash<QPoint, QBrush> liveCells;
     const int cellSize = 5;
 };
 
@@ -2,8 +2,11 @@
 #include "ui_mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "ellipsekernel.h"
+#include "sweepplot.h"
 
 #include <QElapsedTimer>
+#include <QHash>
 #include <QtMath>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -14,9 +17,18 @@
 #include <QSlider>
 #include <QStatusBar>
 #include <QDebug>
+#include <QApplication>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QTableWidget>
 
 static QBrush kPolarBrush = QBrush(QColor(220, 20, 60));
+static QBrush kPolarRecurrenceBrush = QBrush(QColor(255, 140, 0));
 static QBrush kMidBrush   = QBrush(QColor(0, 90, 255));
+static QBrush kFillBrush  = QBrush(QColor(150, 190, 255));
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow)
@@ -68,17 +80,40 @@ MainWindow::MainWindow(QWidget *parent)
     inputRow->addWidget(bInput);
     inputRow->addSpacing(8);
     inputRow->addWidget(bSlider);
+    inputRow->addSpacing(16);
+
+    rotSlider = new QSlider(Qt::Horizontal, this);
+    rotSlider->setRange(0, 179);
+    rotSlider->setTickInterval(15);
+    rotSlider->setTickPosition(QSlider::TicksBelow);
+    rotSlider->setFixedWidth(180);
+    rotSlider->setValue(0);
+    rotLabel = new QLabel("Rotation: 0 deg");
+    rotLabel->setMinimumWidth(90);
+
+    inputRow->addWidget(rotLabel);
+    inputRow->addWidget(rotSlider);
     inputRow->addStretch();
 
     auto *btnRow = new QHBoxLayout;
     auto *btnPolar = new QPushButton("Draw Ellipse (Polar)");
+    auto *btnPolarRec = new QPushButton("Draw Ellipse (Polar, no trig)");
     auto *btnMid   = new QPushButton("Draw Ellipse (Midpoint)");
+    auto *btnFill  = new QPushButton("Fill Ellipse");
+    auto *btnAA    = new QPushButton("Draw Ellipse (Anti-aliased)");
+    auto *btnFillAA = new QPushButton("Fill Ellipse (Anti-aliased)");
     auto *btnClear = new QPushButton("Clear");
     auto *btnPerf  = new QPushButton("Compare Times");
+    auto *btnSweep = new QPushButton("Sweep Axes");
 
     btnRow->addWidget(btnPolar);
+    btnRow->addWidget(btnPolarRec);
     btnRow->addWidget(btnMid);
+    btnRow->addWidget(btnFill);
+    btnRow->addWidget(btnAA);
+    btnRow->addWidget(btnFillAA);
     btnRow->addWidget(btnPerf);
+    btnRow->addWidget(btnSweep);
     btnRow->addStretch();
     btnRow->addWidget(btnClear);
 
@@ -92,9 +127,15 @@ MainWindow::MainWindow(QWidget *parent)
     connect(bInput, &QLineEdit::textChanged, this, &MainWindow::onAxesChanged);
     connect(aSlider, &QSlider::valueChanged, this, &MainWindow::onASliderChanged);
     connect(bSlider, &QSlider::valueChanged, this, &MainWindow::onBSliderChanged);
+    connect(rotSlider, &QSlider::valueChanged, this, &MainWindow::onRotationChanged);
     connect(btnPolar, &QPushButton::clicked, this, &MainWindow::drawEllipsePolar);
+    connect(btnPolarRec, &QPushButton::clicked, this, &MainWindow::drawEllipsePolarRecurrence);
     connect(btnMid,   &QPushButton::clicked, this, &MainWindow::drawEllipseMidpoint);
+    connect(btnFill,  &QPushButton::clicked, this, &MainWindow::drawFilledEllipse);
+    connect(btnAA,    &QPushButton::clicked, this, &MainWindow::drawEllipseAntialiased);
+    connect(btnFillAA, &QPushButton::clicked, this, &MainWindow::drawFilledEllipseAntialiased);
     connect(btnPerf,  &QPushButton::clicked, this, &MainWindow::compareExecutionTimes);
+    connect(btnSweep, &QPushButton::clicked, this, &MainWindow::sweepSizes);
     connect(btnClear, &QPushButton::clicked, scene, &GridScene::clearCells);
 
     animTimer.setSingleShot(false);
@@ -146,6 +187,18 @@ void MainWindow::onBSliderChanged(int value) {
     setStatus(QString("a=%1, b=%2").arg(aSlider->value()).arg(value));
 }
 
+void MainWindow::onRotationChanged(int degrees) {
+    rotLabel->setText(QString("Rotation: %1 deg").arg(degrees));
+    animTimer.stop();
+    if (!haveCenter) { setStatus(QString("Rotation %1 (click to set center)").arg(degrees)); return; }
+    drawEllipseImmediate(aSlider->value(), bSlider->value());
+    setStatus(QString("a=%1, b=%2, rotation=%3").arg(aSlider->value()).arg(bSlider->value()).arg(degrees));
+}
+
+double MainWindow::currentTheta() const {
+    return qDegreesToRadians(double(rotSlider->value()));
+}
+
 int MainWindow::currentA() const {
     QString t = aInput->text();
     return t.isEmpty() ? 20 : t.toInt();
@@ -176,29 +229,53 @@ QVector<QPoint> MainWindow::buildPolarFrames(const QPoint& c, int a, int b) {
     return frames;
 }
 
+QVector<QPoint> MainWindow::buildPolarRecurrenceFrames(const QPoint& c, int a, int b) {
+    QVector<QPoint> frames;
+    EllipseKernel::polarRecurrenceQuadrant(a, b, [&](int x, int y) { frames += fourSymmetry(c, x, y); });
+    return frames;
+}
+
 QVector<QPoint> MainWindow::buildMidpointFrames(const QPoint& c, int a, int b) {
     QVector<QPoint> frames;
-    int x = 0, y = b;
-    int a2 = a*a, b2 = b*b;
-    double d1 = b2 - a2*b + 0.25*a2;
+    EllipseKernel::midpointQuadrant(a, b, [&](int x, int y) { frames += fourSymmetry(c, x, y); });
+    return frames;
+}
 
-    while ((2*b2*x) <= (2*a2*y)) {
-        frames += fourSymmetry(c, x, y);
-        if (d1 < 0) d1 += b2*(2*x + 3);
-        else { d1 += b2*(2*x + 3) + a2*(-2*y + 2); y--; }
-        x++;
-    }
+// The coverage band is two cells wide along a perimeter under 2 pi max(a, b), so
+// 16 (a + b + 1) is room enough
+QVector<QPair<QPoint, qreal>> MainWindow::buildAntialiasedFrames(const QPoint& c, int a, int b) {
+    QVector<QPair<QPoint, qreal>> frames;
+    frames.reserve(16 * (a + b + 1));
+    EllipseKernel::antialiasedOutline(c, a, b, [&](int x, int y, double coverage) {
+        frames.append(qMakePair(QPoint(x, y), qreal(coverage)));
+    });
+    return frames;
+}
 
-    double d2 = b2*(x + 0.5)*(x + 0.5) + a2*(y - 1)*(y - 1) - a2*b2;
-    while (y >= 0) {
-        frames += fourSymmetry(c, x, y);
-        if (d2 < 0) { d2 += b2*(2*x + 2) + a2*(-2*y + 3); x++; }
-        else d2 += a2*(-2*y + 3);
-        y--;
+QVector<QPoint> MainWindow::buildUniqueFrames(Method method, const QPoint& c, int a, int b, int* emitted) {
+    QVector<QPoint> quadrant;
+    auto collect = [&](int x, int y) { quadrant.append(QPoint(x, y)); };
+    switch (method) {
+    case Polar:           EllipseKernel::polarQuadrant(a, b, collect);           break;
+    case PolarRecurrence: EllipseKernel::polarRecurrenceQuadrant(a, b, collect); break;
+    case Midpoint:        EllipseKernel::midpointQuadrant(a, b, collect);        break;
     }
+    if (emitted) *emitted = 4 * quadrant.size();
+
+    QVector<QPoint> frames(4 * quadrant.size());
+    QPoint *out = frames.data();
+    EllipseKernel::traceQuadrants(quadrant, c, [&](int x, int y) { *out++ = QPoint(x, y); });
+    frames.resize(int(out - frames.data()));
     return frames;
 }
 
+void MainWindow::reportOverdraw(const QString& method, int emitted, int unique) {
+    const double ratio = unique > 0 ? double(emitted) / unique : 0.0;
+    qDebug() << "Pixels emitted vs unique (" + method + " Method):" << emitted << "/" << unique
+             << QString("(%1x)").arg(ratio, 0, 'f', 2);
+    setStatus(QString("%1: %2 pixels emitted, %3 unique (%4x)").arg(method).arg(emitted).arg(unique).arg(ratio, 0, 'f', 2));
+}
+
 void MainWindow::beginAnimation(const QVector<QPoint>& frames, const QBrush& brush, int msStep) {
     if (!haveCenter) { setStatus("Select center first"); return; }
     if (aInput->text().isEmpty() || bInput->text().isEmpty()) { setStatus("Enter a and b"); return; }
@@ -210,11 +287,23 @@ void MainWindow::beginAnimation(const QVector<QPoint>& frames, const QBrush& bru
     if (!animFrames.isEmpty()) animTimer.start(msStep);
 }
 
+// The outline and the centre cell are the scene's live overlay: only cells that differ from the
+// previous tick are repainted, and the next drawing commits the overlay beneath itself.
 void MainWindow::drawEllipseImmediate(int a, int b) {
-    scene->clearCells();
-    scene->paintCell(centerCell, QBrush(Qt::blue));
-    const auto pts = buildMidpointFrames(centerCell, a, b);
-    for (const QPoint& p : pts) scene->paintCell(p, kMidBrush);
+    QHash<QPoint, QBrush> next;
+    const QPoint c = centerCell;
+    next.insert(c, QBrush(Qt::blue));
+    if (rotSlider->value() == 0) {
+        EllipseKernel::midpointQuadrant(a, b, [&](int x, int y) {
+            next.insert(QPoint(c.x() + x, c.y() + y), kMidBrush);
+            next.insert(QPoint(c.x() - x, c.y() + y), kMidBrush);
+            next.insert(QPoint(c.x() + x, c.y() - y), kMidBrush);
+            next.insert(QPoint(c.x() - x, c.y() - y), kMidBrush);
+        });
+    } else {
+        EllipseKernel::rotatedOutline(c, a, b, currentTheta(), [&](int x, int y) { next.insert(QPoint(x, y), kMidBrush); });
+    }
+    scene->setLiveCells(next);
 }
 
 void MainWindow::stepAnimation() {
@@ -224,12 +313,71 @@ void MainWindow::stepAnimation() {
 
 void MainWindow::drawEllipsePolar() {
     int a = currentA(), b = currentB();
-    beginAnimation(buildPolarFrames(centerCell, a, b), kPolarBrush, 8);
+    int emitted = 0;
+    auto frames = buildUniqueFrames(Polar, centerCell, a, b, &emitted);
+    reportOverdraw("Polar", emitted, frames.size());
+    beginAnimation(frames, kPolarBrush, 8);
+}
+
+void MainWindow::drawEllipsePolarRecurrence() {
+    int a = currentA(), b = currentB();
+    int emitted = 0;
+    auto frames = buildUniqueFrames(PolarRecurrence, centerCell, a, b, &emitted);
+    reportOverdraw("Polar (no trig)", emitted, frames.size());
+    beginAnimation(frames, kPolarRecurrenceBrush, 8);
 }
 
 void MainWindow::drawEllipseMidpoint() {
     int a = currentA(), b = currentB();
-    beginAnimation(buildMidpointFrames(centerCell, a, b), kMidBrush, 4);
+    int emitted = 0;
+    auto frames = buildUniqueFrames(Midpoint, centerCell, a, b, &emitted);
+    reportOverdraw("Midpoint", emitted, frames.size());
+    beginAnimation(frames, kMidBrush, 4);
+}
+
+// One span per row straight into the scene, instead of a flood fill over every interior cell
+void MainWindow::drawFilledEllipse() {
+    if (!haveCenter) { setStatus("Select center first"); return; }
+    if (aInput->text().isEmpty() || bInput->text().isEmpty()) { setStatus("Enter a and b"); return; }
+    animTimer.stop();
+    int spans = 0;
+    auto paint = [&](int y, int x0, int x1) {
+        scene->paintSpan(y, x0, x1, kFillBrush);
+        ++spans;
+    };
+    if (rotSlider->value() == 0) EllipseKernel::filledMidpoint(centerCell, currentA(), currentB(), paint);
+    else EllipseKernel::filledRotated(centerCell, currentA(), currentB(), currentTheta(), paint);
+    scene->paintCell(centerCell, QBrush(Qt::blue));
+    setStatus(QString("Filled ellipse: %1 span writes").arg(spans));
+}
+
+// Anti-aliasing follows the axis-aligned ellipse; the rotation slider does not apply to it.
+// Coverage is composited over the scene, so drawing over other shapes blends with them.
+void MainWindow::drawEllipseAntialiased() {
+    if (!haveCenter) { setStatus("Select center first"); return; }
+    if (aInput->text().isEmpty() || bInput->text().isEmpty()) { setStatus("Enter a and b"); return; }
+    animTimer.stop();
+    const QVector<QPair<QPoint, qreal>> cells = buildAntialiasedFrames(centerCell, currentA(), currentB());
+    scene->blendCells(cells, kMidBrush.color());
+    setStatus(QString("Anti-aliased outline: %1 cells%2").arg(cells.size())
+                  .arg(rotSlider->value() != 0 ? " (rotation ignored)" : ""));
+}
+
+// Solid runs go in as spans, like drawFilledEllipse; only the edge cells are blended
+void MainWindow::drawFilledEllipseAntialiased() {
+    if (!haveCenter) { setStatus("Select center first"); return; }
+    if (aInput->text().isEmpty() || bInput->text().isEmpty()) { setStatus("Enter a and b"); return; }
+    animTimer.stop();
+    const int a = currentA(), b = currentB();
+    QVector<QPair<QPoint, qreal>> edge;
+    edge.reserve(16 * (a + b + 1));
+    int spans = 0;
+    EllipseKernel::antialiasedFill(centerCell, a, b,
+        [&](int y, int x0, int x1) { scene->paintSpan(y, x0, x1, kFillBrush); ++spans; },
+        [&](int x, int y, double coverage) { edge.append(qMakePair(QPoint(x, y), qreal(coverage))); });
+    scene->blendCells(edge, kFillBrush.color());
+    setStatus(QString("Anti-aliased ellipse: %1 span writes, %2 edge cells%3").arg(spans).arg(edge.size())
+                  .arg(rotSlider->value() != 0 ? " (rotation ignored)" : ""));
 }
 
 void MainWindow::compareExecutionTimes() {
@@ -239,15 +387,124 @@ void MainWindow::compareExecutionTimes() {
     int a = currentA(), b = currentB();
     const int iters = 200;
     QElapsedTimer t;
-    qint64 tp = 0, tm = 0;
+    qint64 tp = 0, tr = 0, tm = 0;
 
     t.start();
     for (int i=0;i<iters;++i) volatile auto v = buildPolarFrames(centerCell, a, b);
     tp = t.nsecsElapsed();
 
+    t.restart();
+    for (int i=0;i<iters;++i) volatile auto v = buildPolarRecurrenceFrames(centerCell, a, b);
+    tr = t.nsecsElapsed();
+
     t.restart();
     for (int i=0;i<iters;++i) volatile auto v = buildMidpointFrames(centerCell, a, b);
     tm = t.nsecsElapsed();
 
-    setStatus(QString("Avg ns: Polar %1 | Midpoint %2").arg(tp/iters).arg(tm/iters));
+    int polarEmitted = 0, midEmitted = 0;
+    const int polarUnique = buildUniqueFrames(Polar, centerCell, a, b, &polarEmitted).size();
+    const int midUnique = buildUniqueFrames(Midpoint, centerCell, a, b, &midEmitted).size();
+    qDebug() << "Pixels emitted vs unique: Polar" << polarEmitted << "/" << polarUnique
+             << "| Midpoint" << midEmitted << "/" << midUnique;
+
+    const QVector<QPoint> trig = buildPolarFrames(centerCell, a, b), rec = buildPolarRecurrenceFrames(centerCell, a, b);
+    int differing = qAbs(trig.size() - rec.size());
+    for (int i = 0; i < qMin(trig.size(), rec.size()); ++i)
+        if (trig[i] != rec[i]) ++differing;
+    qDebug() << "Cells where polar without trig differs from trig polar:" << differing;
+
+    setStatus(QString("Avg ns: Polar %1 | Polar (no trig) %2 | Midpoint %3").arg(tp/iters).arg(tr/iters).arg(tm/iters));
+}
+
+// Semi-major axis a = 1..10^5 on a log scale, with b = a / 2. Midpoint goes first, so the
+// pixel counts every method is normalised by are the distinct cells of the midpoint ellipse.
+void MainWindow::sweepSizes() {
+    animTimer.stop();
+    const QPoint origin(0, 0);
+    SweepBenchmark bench;
+    bench.addAlgorithm("Midpoint", [this, origin](int a) { return buildMidpointFrames(origin, a, qMax(1, a / 2)); });
+    bench.addAlgorithm("Polar", [this, origin](int a) { return buildPolarFrames(origin, a, qMax(1, a / 2)); });
+    bench.addAlgorithm("Polar (no trig)", [this, origin](int a) { return buildPolarRecurrenceFrames(origin, a, qMax(1, a / 2)); });
+    bench.addAlgorithm("Anti-aliased", [origin](int a) {
+        const int b = qMax(1, a / 2);
+        QVector<QPoint> cells;
+        cells.reserve(16 * (a + b + 1));
+        EllipseKernel::antialiasedOutline(origin, a, b, [&](int x, int y, double coverage) {
+            if (coverage > 0.0) cells.append(QPoint(x, y));   // keeps the coverage computed
+        });
+        return cells;
+    });
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const QVector<SweepBenchmark::Row> rows = bench.run();
+    QApplication::restoreOverrideCursor();
+
+    for (const SweepBenchmark::Row& row : rows) {
+        qDebug() << "Axes" << row.size << qMax(1, row.size / 2) << "pixels" << row.pixels;
+        for (int i = 0; i < row.nsPerPixel.size(); ++i)
+            qDebug() << "   " << bench.algorithmNames().at(i) << row.nsPerPixel[i].mean << "+/-" << row.nsPerPixel[i].ci95
+                     << "ns/pixel," << row.allocations[i] << "allocations";
+    }
+
+    showSweep(bench, rows);
+}
+
+void MainWindow::showSweep(const SweepBenchmark& bench, const QVector<SweepBenchmark::Row>& rows) {
+    const QStringList names = bench.algorithmNames();
+
+    QStringList headers = { "a", "Pixels" };
+    for (const QString& name : names)
+        headers << name + " ns/px" << name + " allocs";
+
+    QTableWidget *table = new QTableWidget(rows.size(), headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    for (int r = 0; r < rows.size(); ++r) {
+        const SweepBenchmark::Row& row = rows[r];
+        int c = 0;
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.size)));
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.pixels)));
+        for (int i = 0; i < row.nsPerPixel.size(); ++i) {
+            const SweepBenchmark::Stat& s = row.nsPerPixel[i];
+            table->setItem(r, c++, new QTableWidgetItem(QString("%1 +/- %2").arg(s.mean, 0, 'f', 3).arg(s.ci95, 0, 'f', 3)));
+            table->setItem(r, c++, new QTableWidgetItem(row.allocations[i] < 0 ? QString("n/a") : QString::number(row.allocations[i])));
+        }
+    }
+    table->resizeColumnsToContents();
+
+    SweepPlot *plot = new SweepPlot;
+    plot->setResults(names, rows);
+
+    QString pinned = bench.pinnedCpu() >= 0 ? QString("pinned to CPU %1").arg(bench.pinnedCpu()) : QString("not pinned");
+    QLabel *summary = new QLabel(QString("Ellipse outlines with b = a / 2, mean +/- 95% confidence interval over %1 timed "
+                                         "repetitions after warm-up; thread %2. Allocations are heap calls per ellipse%3.")
+                                     .arg(bench.repetitions()).arg(pinned)
+                                     .arg(SweepBenchmark::countsAllocations() ? "" : " (not counted in this build)"));
+    summary->setWordWrap(true);
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Ellipse axis sweep");
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    QPushButton *btnCsv = buttons->addButton("Export CSV...", QDialogButtonBox::ActionRole);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(btnCsv, &QPushButton::clicked, &dialog, [&] {
+        const QString path = QFileDialog::getSaveFileName(&dialog, "Export CSV", "ellipse-sweep.csv", "CSV files (*.csv)");
+        if (path.isEmpty()) return;
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            setStatus(QString("Could not write %1").arg(path));
+            return;
+        }
+        file.write(bench.toCsv(rows).toUtf8());
+        setStatus(QString("Sweep written to %1").arg(path));
+    });
+
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    layout->addWidget(summary);
+    layout->addWidget(plot, 3);
+    layout->addWidget(table, 2);
+    layout->addWidget(buttons);
+    dialog.resize(900, 720);
+    dialog.exec();
 }
@@ -2,13 +2,16 @@
 #include <QMainWindow>
 #include <QPoint>
 #include <QVector>
+#include <QPair>
 #include <QTimer>
 #include <QLineEdit>
 #include <QBrush>
+#include "sweepbench.h"
 
 class GridScene;
 class GridView;
 class QSlider;
+class QLabel;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -25,20 +28,36 @@ private slots:
     void onAxesChanged();
     void onASliderChanged(int value);
     void onBSliderChanged(int value);
+    void onRotationChanged(int degrees);
     void drawEllipsePolar();
+    void drawEllipsePolarRecurrence();
     void drawEllipseMidpoint();
+    void drawFilledEllipse();
+    void drawEllipseAntialiased();
+    void drawFilledEllipseAntialiased();
     void compareExecutionTimes();
+    void sweepSizes();
     void stepAnimation();
 
 private:
+    enum Method { Polar, PolarRecurrence, Midpoint };
+
     int  currentA() const;
     int  currentB() const;
+    double currentTheta() const;
     void setStatus(const QString& s);
     void beginAnimation(const QVector<QPoint>& frames, const QBrush& brush, int msStep);
     void drawEllipseImmediate(int a, int b);
     static QVector<QPoint> fourSymmetry(const QPoint& c, int x, int y);
     QVector<QPoint> buildPolarFrames(const QPoint& c, int a, int b);
+    QVector<QPoint> buildPolarRecurrenceFrames(const QPoint& c, int a, int b);
     QVector<QPoint> buildMidpointFrames(const QPoint& c, int a, int b);
+    QVector<QPair<QPoint, qreal>> buildAntialiasedFrames(const QPoint& c, int a, int b);
+    // Each cell of the method's ellipse once, in angular order. `emitted` receives how many
+    // points the four-way builders above produce for the same axes.
+    QVector<QPoint> buildUniqueFrames(Method method, const QPoint& c, int a, int b, int* emitted = nullptr);
+    void reportOverdraw(const QString& method, int emitted, int unique);
+    void showSweep(const SweepBenchmark& bench, const QVector<SweepBenchmark::Row>& rows);
 
 private:
     Ui::MainWindow *ui;
@@ -50,6 +69,8 @@ private:
     QLineEdit* bInput = nullptr;
     QSlider*   aSlider = nullptr;
     QSlider*   bSlider = nullptr;
+    QSlider*   rotSlider = nullptr;
+    QLabel*    rotLabel = nullptr;
 
     bool   haveCenter = false;
     QPoint centerCell;
@@ -0,0 +1,298 @@
+#include "sweepbench.h"
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Bumped by the allocator hooks below while `countAllocations` is set
+std::atomic<bool> countAllocations{false};
+std::atomic<qint64> allocationCount{0};
+
+inline void noteAllocation()
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+// Counting is a benchmark-only build option (qmake CONFIG+=sweep_alloc_count), since it
+// replaces the process-wide allocator. On glibc the executable then interposes malloc and
+// its aligned variants and forwards to the real allocator. Qt's containers allocate through
+// malloc/realloc, and operator new calls malloc, so this sees every heap allocation a
+// rasteriser makes. Other builds do not count allocations.
+#if defined(SWEEP_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+#define SWEEP_HOOKS_ALLOCATOR
+#include <cerrno>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+
+void *malloc(size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+{
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+    noteAllocation();
+    void *p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void *valloc(size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size) noexcept
+{
+    noteAllocation();
+    return __libc_pvalloc(size);
+}
+}
+#endif
+
+namespace {
+
+// Keeps the calling thread on the CPU it is running on until it goes out of scope.
+// Migrations between cores with different clocks or cold caches would otherwise add to the
+// spread of the timings.
+class ThreadPin {
+public:
+    ThreadPin()
+    {
+#if defined(Q_OS_WIN)
+        const DWORD current = GetCurrentProcessorNumber();
+        if (current < sizeof(DWORD_PTR) * 8) {
+            oldMask = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << current);
+            if (oldMask) cpu = int(current);
+        }
+#elif defined(Q_OS_LINUX)
+        const int current = sched_getcpu();
+        if (current >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(oldSet), &oldSet) == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(current, &one);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(one), &one) == 0) cpu = current;
+        }
+#endif
+    }
+
+    ~ThreadPin()
+    {
+        if (cpu < 0) return;
+#if defined(Q_OS_WIN)
+        SetThreadAffinityMask(GetCurrentThread(), oldMask);
+#elif defined(Q_OS_LINUX)
+        pthread_setaffinity_np(pthread_self(), sizeof(oldSet), &oldSet);
+#endif
+    }
+
+    int cpu = -1;
+
+private:
+#if defined(Q_OS_WIN)
+    DWORD_PTR oldMask = 0;
+#elif defined(Q_OS_LINUX)
+    cpu_set_t oldSet;
+#endif
+};
+
+// Two-sided 95% quantile of Student's t for 1..30 degrees of freedom; the normal value
+// is close enough past that.
+double tQuantile95(int df)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return 0.0;
+    return df <= 30 ? table[df - 1] : 1.960;
+}
+
+SweepBenchmark::Stat summarise(const QVector<double>& samples)
+{
+    SweepBenchmark::Stat s;
+    const int n = samples.size();
+    if (n == 0) return s;
+
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    s.mean = sum / n;
+    if (n < 2) return s;
+
+    double sq = 0.0;
+    for (double v : samples) sq += (v - s.mean) * (v - s.mean);
+    s.ci95 = tQuantile95(n - 1) * std::sqrt(sq / (n - 1)) / std::sqrt(double(n));
+    return s;
+}
+
+qint64 distinctCells(QVector<QPoint> cells)
+{
+    auto less = [](const QPoint& p, const QPoint& q) { return p.y() != q.y() ? p.y() < q.y() : p.x() < q.x(); };
+    std::sort(cells.begin(), cells.end(), less);
+    return std::unique(cells.begin(), cells.end()) - cells.begin();
+}
+
+} // namespace
+
+void SweepBenchmark::addAlgorithm(const QString& name, ShapeFn fn)
+{
+    algorithms.append({ name, std::move(fn) });
+}
+
+QStringList SweepBenchmark::algorithmNames() const
+{
+    QStringList names;
+    for (const Algorithm& a : algorithms) names << a.name;
+    return names;
+}
+
+bool SweepBenchmark::countsAllocations()
+{
+#if defined(SWEEP_HOOKS_ALLOCATOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+QVector<SweepBenchmark::Row> SweepBenchmark::run(int maxSize, int stepsPerDecade, int repetitions)
+{
+    const qint64 targetNs = 1000000;      // each timed sample runs for at least 1 ms
+    const int n = algorithms.size();
+    reps = qMax(2, repetitions);
+
+    QVector<Row> rows;
+    if (n == 0 || maxSize < 1 || stepsPerDecade <= 0) return rows;
+
+    for (int k = 0;; ++k) {
+        const int size = int(std::lround(std::pow(10.0, double(k) / stepsPerDecade)));
+        if (size > maxSize) break;
+        if (!rows.isEmpty() && rows.last().size == size) continue;
+        Row row;
+        row.size = size;
+        rows.append(row);
+    }
+
+    // pixel and allocation counts come from untimed runs
+    for (Row& row : rows) {
+        row.pixels = distinctCells(algorithms[0].fn(row.size));
+        for (int a = 0; a < n; ++a) {
+            algorithms[a].fn(row.size);     // let any lazily built state settle first
+            allocationCount.store(0);
+            countAllocations.store(true);
+            const QVector<QPoint> cells = algorithms[a].fn(row.size);
+            countAllocations.store(false);
+            row.allocations.append(countsAllocations() ? allocationCount.load() : -1);
+        }
+    }
+
+    ThreadPin pin;
+    cpu = pin.cpu;
+    qint64 checksum = 0;
+
+    // samples[s][a] is ns/pixel for size s and algorithm a, one per repetition. The inner
+    // loop is sized per algorithm so that a small shape is still timed over about 1 ms.
+    // Each repetition rotates the algorithm order so slow drift is not pinned on one.
+    QVector<QVector<QVector<double>>> samples(rows.size(), QVector<QVector<double>>(n));
+    for (int s = 0; s < rows.size(); ++s) {
+        const int size = rows[s].size;
+        QVector<int> inner(n, 1);
+        for (int a = 0; a < n; ++a) {
+            for (int w = 0; w < 3; ++w) checksum += algorithms[a].fn(size).size();
+            QElapsedTimer timer;
+            timer.start();
+            checksum += algorithms[a].fn(size).size();
+            const qint64 ns = qMax<qint64>(1, timer.nsecsElapsed());
+            inner[a] = int(qBound<qint64>(1, (targetNs + ns - 1) / ns, 1000000));
+        }
+        for (int r = 0; r < reps; ++r) {
+            for (int k = 0; k < n; ++k) {
+                const int a = (r + k) % n;
+                QElapsedTimer timer;
+                timer.start();
+                for (int i = 0; i < inner[a]; ++i)
+                    checksum += algorithms[a].fn(size).size();
+                const double perShape = double(timer.nsecsElapsed()) / inner[a];
+                samples[s][a].append(perShape / qMax<qint64>(1, rows[s].pixels));
+            }
+        }
+        for (int a = 0; a < n; ++a)
+            rows[s].nsPerPixel.append(summarise(samples[s][a]));
+    }
+
+    static volatile qint64 sink;
+    sink = checksum;
+    return rows;
+}
+
+QString SweepBenchmark::toCsv(const QVector<Row>& rows) const
+{
+    QStringList header = { "size", "pixels" };
+    for (const Algorithm& a : algorithms) {
+        QString name = a.name;
+        name.replace('"', "\"\"");
+        header << QString("\"%1 ns/px\"").arg(name) << QString("\"%1 ci95\"").arg(name)
+               << QString("\"%1 allocs\"").arg(name);
+    }
+
+    QString csv = header.join(',') + '\n';
+    for (const Row& row : rows) {
+        QStringList fields = { QString::number(row.size), QString::number(row.pixels) };
+        for (int a = 0; a < row.nsPerPixel.size(); ++a) {
+            fields << QString::number(row.nsPerPixel[a].mean, 'f', 4)
+                   << QString::number(row.nsPerPixel[a].ci95, 'f', 4)
+                   << (row.allocations[a] < 0 ? QString() : QString::number(row.allocations[a]));
+        }
+        csv += fields.join(',') + '\n';
+    }
+    return csv;
+}
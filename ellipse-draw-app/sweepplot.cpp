@@ -0,0 +1,78 @@
+#include "sweepplot.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QtMath>
+
+SweepPlot::SweepPlot(QWidget* parent) : QWidget(parent) {
+    setMinimumSize(480, 300);
+    setAutoFillBackground(true);
+    setBackgroundRole(QPalette::Base);
+}
+
+void SweepPlot::setResults(const QStringList& algorithmNames, const QVector<SweepBenchmark::Row>& results) {
+    names = algorithmNames;
+    rows = results;
+    update();
+}
+
+void SweepPlot::paintEvent(QPaintEvent*) {
+    if (rows.isEmpty() || names.isEmpty()) return;
+
+    // both axes span whole decades around the data
+    double yMin = 1e300, yMax = 0.0;
+    for (const SweepBenchmark::Row& row : rows) {
+        for (const SweepBenchmark::Stat& s : row.nsPerPixel) {
+            if (s.mean <= 0.0) continue;
+            yMin = qMin(yMin, s.mean);
+            yMax = qMax(yMax, s.mean);
+        }
+    }
+    if (yMax <= 0.0) return;
+    const int x0 = 0, x1 = qMax(1, qCeil(std::log10(double(rows.last().size))));
+    const int y0 = qFloor(std::log10(yMin)), y1 = qMax(y0 + 1, qCeil(std::log10(yMax)));
+
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    const QRectF area = QRectF(rect()).adjusted(56, 12, -16, -40);
+    auto mapX = [&](double size) { return area.left() + (std::log10(size) - x0) / (x1 - x0) * area.width(); };
+    auto mapY = [&](double ns) { return area.bottom() - (std::log10(ns) - y0) / (y1 - y0) * area.height(); };
+
+    p.setPen(QColor(225, 225, 225));
+    for (int k = x0; k <= x1; ++k) p.drawLine(QPointF(mapX(qPow(10.0, k)), area.top()), QPointF(mapX(qPow(10.0, k)), area.bottom()));
+    for (int k = y0; k <= y1; ++k) p.drawLine(QPointF(area.left(), mapY(qPow(10.0, k))), QPointF(area.right(), mapY(qPow(10.0, k))));
+
+    p.setPen(palette().color(QPalette::Text));
+    p.drawRect(area);
+    for (int k = x0; k <= x1; ++k)
+        p.drawText(QRectF(mapX(qPow(10.0, k)) - 30, area.bottom() + 4, 60, 16), Qt::AlignCenter, QString::number(qPow(10.0, k)));
+    for (int k = y0; k <= y1; ++k)
+        p.drawText(QRectF(0, mapY(qPow(10.0, k)) - 8, area.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter, QString::number(qPow(10.0, k)));
+    p.drawText(QRectF(area.left(), area.bottom() + 20, area.width(), 16), Qt::AlignCenter, "size (cells)");
+    p.save();
+    p.translate(12, area.center().y());
+    p.rotate(-90);
+    p.drawText(QRectF(-60, -8, 120, 16), Qt::AlignCenter, "ns / pixel");
+    p.restore();
+
+    static const QColor colors[] = {
+        QColor(0, 90, 255), QColor(220, 20, 60), QColor(255, 140, 0),
+        QColor(30, 150, 60), QColor(140, 40, 180), QColor(100, 100, 100)
+    };
+    const int ncolors = int(sizeof(colors) / sizeof(colors[0]));
+    for (int a = 0; a < names.size(); ++a) {
+        QPainterPath path;
+        for (const SweepBenchmark::Row& row : rows) {
+            if (a >= row.nsPerPixel.size() || row.nsPerPixel[a].mean <= 0.0) continue;
+            const QPointF pt(mapX(row.size), mapY(row.nsPerPixel[a].mean));
+            if (path.elementCount() == 0) path.moveTo(pt);
+            else path.lineTo(pt);
+        }
+        p.setPen(QPen(colors[a % ncolors], 2));
+        p.drawPath(path);
+
+        const QPointF key(area.right() - 170, area.top() + 10 + 16 * a);
+        p.drawLine(key, key + QPointF(20, 0));
+        p.setPen(palette().color(QPalette::Text));
+        p.drawText(QRectF(key.x() + 26, key.y() - 8, 150, 16), Qt::AlignLeft | Qt::AlignVCenter, names[a]);
+    }
+}
@@ -17,7 +17,9 @@ SOURCES += \
 HEADERS += \
     gridscene.h \
     gridview.h \
-    mainwindow.h
+    linekernel.h \
+    mainwindow.h \
+    seedfill.h
 
 FORMS += \
     mainwindow.ui
@@ -21,6 +21,41 @@ QBrush GridScene::getCellBrush(const QPoint& cell) const {
     return QBrush();
 }
 
+GridScene::Snapshot GridScene::snapshot(const QRect& box) const {
+    Snapshot s;
+    s.box = box;
+    s.palette.append(PaletteEntry());
+    s.cells.fill(0, box.width() * box.height());
+
+    auto entry = [&s](const QBrush& brush, bool painted, const QBrush& paintedBrush) -> quint16 {
+        for (int i = 0; i < s.palette.size(); ++i) {
+            const PaletteEntry& e = s.palette[i];
+            if (e.brush == brush && e.painted == painted && (!painted || e.paintedBrush == paintedBrush))
+                return quint16(i);
+        }
+        s.palette.append({ brush, painted, paintedBrush });
+        return quint16(s.palette.size() - 1);
+    };
+
+    // the axes read as black, painted or not
+    const quint16 axis = entry(QBrush(Qt::black), false, QBrush());
+    if (box.left() <= 0 && box.right() >= 0)
+        for (int y = box.top(); y <= box.bottom(); ++y) s.cells[(y - box.top()) * box.width() - box.left()] = axis;
+    if (box.top() <= 0 && box.bottom() >= 0)
+        for (int x = box.left(); x <= box.right(); ++x) s.cells[-box.top() * box.width() + (x - box.left())] = axis;
+
+    // one pass over the painted cells rather than a hash probe per cell of the box
+    for (auto it = cellItems.cbegin(); it != cellItems.cend(); ++it) {
+        const QPoint& c = it.key();
+        if (!box.contains(c)) continue;
+        const QBrush painted = it.value()->brush();
+        const bool onAxis = c.x() == 0 || c.y() == 0;
+        s.cells[(c.y() - box.top()) * box.width() + (c.x() - box.left())] =
+            entry(onAxis ? QBrush(Qt::black) : painted, true, painted);
+    }
+    return s;
+}
+
 void GridScene::paintCell(const QPoint& cell, const QBrush& brush) {
     if (!cellItems.contains(cell)) {
         auto *rect = addRect(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize, Qt::NoPen, brush);
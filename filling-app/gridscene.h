@@ -5,12 +5,33 @@
 #include <QMap>
 #include <QPoint>
 #include <QBrush>
+#include <QRect>
+#include <QVector>
 #include <QGraphicsRectItem>
 
 class GridScene : public QGraphicsScene {
     Q_OBJECT
 
 public:
+    // A distinct cell state: what getCellBrush() reports and what the cell is painted with
+    struct PaletteEntry {
+        QBrush brush;
+        bool painted = false;
+        QBrush paintedBrush;
+
+        bool isPaintedWith(const QBrush& b) const { return painted && paintedBrush.color() == b.color(); }
+    };
+
+    // Cells of a rectangle as indices into a palette of their distinct states, row-major.
+    // Entry 0 is the unpainted cell.
+    struct Snapshot {
+        QRect box;
+        QVector<PaletteEntry> palette;
+        QVector<quint16> cells;
+
+        int at(int x, int y) const { return cells[(y - box.top()) * box.width() + (x - box.left())]; }
+    };
+
     explicit GridScene(QObject *parent = nullptr);
 
     void paintCell(const QPoint& cell, const QBrush& brush);
@@ -18,6 +39,7 @@ public:
     void clearCellsWithBrushes(const QList<QBrush>& brushes);
     bool isCellPaintedWith(const QPoint& cell, const QBrush& brush) const;
     QBrush getCellBrush(const QPoint& cell) const;
+    Snapshot snapshot(const QRect& box) const;
 
 signals:
     void cellClicked(const QPoint& cell);
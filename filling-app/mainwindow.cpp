@@ -2,13 +2,13 @@
 #include "ui_mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QComboBox>
 #include <QLabel>
 #include <QDebug>
 #include <QSet>
-#include <queue>
 #include <stack>
 #include <cmath>
 
@@ -248,19 +248,10 @@ bool MainWindow::isEightConnected() const {
 // Bresenham line
 QVector<QPoint> MainWindow::computeBresenhamLine(const QPoint& p1, const QPoint& p2) const {
     QVector<QPoint> points;
-    int x1 = p1.x(), y1 = p1.y();
-    int x2 = p2.x(), y2 = p2.y();
-    int dx = qAbs(x2 - x1), sx = x1 < x2 ? 1 : -1;
-    int dy = qAbs(y2 - y1), sy = y1 < y2 ? 1 : -1;
-    int err = dx - dy;
-    int x = x1, y = y1;
-    while (true) {
+    points.reserve(qMax(qAbs(p2.x() - p1.x()), qAbs(p2.y() - p1.y())) + 1);
+    LineKernel::bresenham(p1, p2, [&](int x, int y) {
         points.append(QPoint(x, y));
-        if (x == x2 && y == y2) break;
-        int e2 = err * 2;
-        if (e2 > -dy) { err -= dy; x += sx; }
-        if (e2 < dx)  { err += dx; y += sy; }
-    }
+    });
     return points;
 }
 
@@ -299,150 +290,106 @@ static void computeBoundingBox(const QVector<QPoint>& pts, const QRectF& sceneRe
     }
 }
 
-// Flood fill (BFS)
+// Cells of the spans in fill order, left to right within each span
+static QVector<QPoint> spanCells(const QVector<SeedFill::Span>& spans, qint64 cells) {
+    QVector<QPoint> points;
+    points.reserve(int(cells));
+    for (const SeedFill::Span& s : spans)
+        for (int x = s.x0; x <= s.x1; ++x) points.append(QPoint(x, s.y));
+    return points;
+}
+
+// Flood fill (scanline seed fill)
 QVector<QPoint> MainWindow::floodFillPoints(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush) {
-    QVector<QPoint> filled;
-    if (!scene) return filled;
+    QVector<SeedFill::Span> spans;
+    const qint64 cells = floodFillSpans(seed, eightConnected, boundaryBrush, fillBrush, spans);
+    qDebug() << "Flood fill points computed:" << cells << "in" << spans.size() << "spans";
+    return spanCells(spans, cells);
+}
+
+qint64 MainWindow::floodFillSpans(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush, QVector<SeedFill::Span>& spans) {
+    if (!scene) return 0;
 
     const int CELL_SIZE = 5;
     int minX, maxX, minY, maxY;
     computeBoundingBox(selectedPoints, scene->sceneRect(), minX, maxX, minY, maxY, CELL_SIZE);
 
-    std::queue<QPoint> q;
-    QSet<QPoint> visited;
-
     // Check if seed is valid
     if (seed.x() < minX || seed.x() > maxX || seed.y() < minY || seed.y() > maxY) {
         qDebug() << "Seed out of bounds";
-        return filled;
+        return 0;
     }
 
+    const GridScene::Snapshot snap = scene->snapshot(QRect(QPoint(minX, minY), QPoint(maxX, maxY)));
+
     // Get the starting color at seed point
-    QBrush startBrush = scene->getCellBrush(seed);
+    const GridScene::PaletteEntry& start = snap.palette[snap.at(seed.x(), seed.y())];
 
     // If seed is already filled with target color, don't proceed
-    if (scene->isCellPaintedWith(seed, fillBrush)) {
+    if (start.isPaintedWith(fillBrush)) {
         qDebug() << "Seed is already filled";
-        return filled;
+        return 0;
     }
 
     // If seed color matches boundary color, don't proceed
-    if (startBrush == boundaryBrush) {
+    if (start.brush == boundaryBrush) {
         qDebug() << "Seed is on boundary, cannot fill";
-        return filled;
+        return 0;
     }
 
-    q.push(seed);
-    visited.insert(seed);
-
-    while (!q.empty()) {
-        QPoint p = q.front();
-        q.pop();
-        filled.append(p);
-
-        QVector<QPoint> neighbors;
-        neighbors << QPoint(p.x()+1, p.y()) << QPoint(p.x()-1, p.y())
-                  << QPoint(p.x(), p.y()+1) << QPoint(p.x(), p.y()-1);
-
-        if (eightConnected) {
-            neighbors << QPoint(p.x()+1, p.y()+1) << QPoint(p.x()-1, p.y()-1)
-            << QPoint(p.x()+1, p.y()-1) << QPoint(p.x()-1, p.y()+1);
-        }
-
-        for (const QPoint &n : neighbors) {
-            if (n.x() < minX || n.x() > maxX || n.y() < minY || n.y() > maxY)
-                continue;
-
-            if (visited.contains(n))
-                continue;
-
-            // FLOOD FILL KEY DIFFERENCE: Stop at ANY color different from start color
-            QBrush neighborBrush = scene->getCellBrush(n);
-            if (neighborBrush != startBrush)  // Different from original area color
-                continue;
-
-            // Also don't cross already filled areas
-            if (scene->isCellPaintedWith(n, fillBrush))
-                continue;
-
-            visited.insert(n);
-            q.push(n);
-        }
-    }
+    // FLOOD FILL KEY DIFFERENCE: Stop at ANY color different from start color,
+    // and don't cross already filled areas. Decided once per palette entry.
+    QVector<bool> open(snap.palette.size());
+    for (int i = 0; i < snap.palette.size(); ++i)
+        open[i] = snap.palette[i].brush == start.brush && !snap.palette[i].isPaintedWith(fillBrush);
 
-    qDebug() << "Flood fill points computed:" << filled.size();
-    return filled;
+    return SeedFill::scanline(seed, snap.box, eightConnected, [&](int x, int y) { return open[snap.at(x, y)]; },
+                              [&](int y, int x0, int x1) { spans.append({ y, x0, x1 }); });
 }
 
-// Boundary fill (queue)
+// Boundary fill (scanline seed fill)
 QVector<QPoint> MainWindow::boundaryFillPoints(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush) {
-    QVector<QPoint> filled;
-    if (!scene) return filled;
+    QVector<SeedFill::Span> spans;
+    const qint64 cells = boundaryFillSpans(seed, eightConnected, boundaryBrush, fillBrush, spans);
+    qDebug() << "Boundary fill points computed:" << cells << "in" << spans.size() << "spans";
+    return spanCells(spans, cells);
+}
+
+qint64 MainWindow::boundaryFillSpans(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush, QVector<SeedFill::Span>& spans) {
+    if (!scene) return 0;
 
     const int CELL_SIZE = 5;
     int minX, maxX, minY, maxY;
     computeBoundingBox(selectedPoints, scene->sceneRect(), minX, maxX, minY, maxY, CELL_SIZE);
 
-    std::queue<QPoint> q;
-    QSet<QPoint> visited;
-
     // Check if seed is valid
     if (seed.x() < minX || seed.x() > maxX || seed.y() < minY || seed.y() > maxY) {
         qDebug() << "Seed out of bounds";
-        return filled;
+        return 0;
     }
 
+    const GridScene::Snapshot snap = scene->snapshot(QRect(QPoint(minX, minY), QPoint(maxX, maxY)));
+    const GridScene::PaletteEntry& start = snap.palette[snap.at(seed.x(), seed.y())];
+
     // If seed is on boundary, don't proceed
-    if (scene->isCellPaintedWith(seed, boundaryBrush)) {
+    if (start.isPaintedWith(boundaryBrush)) {
         qDebug() << "Seed is on boundary, cannot fill";
-        return filled;
+        return 0;
     }
 
     // If seed is already filled, don't proceed
-    if (scene->isCellPaintedWith(seed, fillBrush)) {
+    if (start.isPaintedWith(fillBrush)) {
         qDebug() << "Seed is already filled";
-        return filled;
+        return 0;
     }
 
-    q.push(seed);
-    visited.insert(seed);
-
-    while (!q.empty()) {
-        QPoint p = q.front();
-        q.pop();
-
-        // Skip boundary cells
-        if (scene->isCellPaintedWith(p, boundaryBrush))
-            continue;
-
-        // Skip already filled cells
-        if (scene->isCellPaintedWith(p, fillBrush))
-            continue;
-
-        filled.append(p);
-
-        QVector<QPoint> neighbors;
-        neighbors << QPoint(p.x()+1, p.y()) << QPoint(p.x()-1, p.y()) << QPoint(p.x(), p.y()+1) << QPoint(p.x(), p.y()-1);
-
-        if (eightConnected) {
-            neighbors << QPoint(p.x()+1, p.y()+1) << QPoint(p.x()-1, p.y()-1) << QPoint(p.x()+1, p.y()-1) << QPoint(p.x()-1, p.y()+1);
-        }
-
-        for (const QPoint &n : neighbors) {
-            if (n.x() < minX || n.x() > maxX || n.y() < minY || n.y() > maxY)
-                continue;
-
-            if (!visited.contains(n) &&
-                !scene->isCellPaintedWith(n, boundaryBrush) &&
-                !scene->isCellPaintedWith(n, fillBrush)) {
-                visited.insert(n);
-                q.push(n);
-            }
-        }
-    }
+    // Stop at boundary cells and at cells that are already filled
+    QVector<bool> open(snap.palette.size());
+    for (int i = 0; i < snap.palette.size(); ++i)
+        open[i] = !snap.palette[i].isPaintedWith(boundaryBrush) && !snap.palette[i].isPaintedWith(fillBrush);
 
-    qDebug() << "Boundary fill points computed:" << filled.size();
-    return filled;
+    return SeedFill::scanline(seed, snap.box, eightConnected, [&](int x, int y) { return open[snap.at(x, y)]; },
+                              [&](int y, int x0, int x1) { spans.append({ y, x0, x1 }); });
 }
 
 
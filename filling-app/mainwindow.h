@@ -10,6 +10,7 @@
 #include <QMap>
 #include <QBrush>
 #include <QSet>
+#include "seedfill.h"
 
 class GridScene;
 class GridView;
@@ -104,6 +105,9 @@ private:
     QVector<QPoint> floodFillPoints(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush);
     QVector<QPoint> boundaryFillPoints(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush);
     QVector<QPoint> scanlineFillPoints(const QBrush& boundaryBrush, const QBrush& fillBrush);
+    // Region of the seed fills as horizontal spans; return the number of cells
+    qint64 floodFillSpans(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush, QVector<SeedFill::Span>& spans);
+    qint64 boundaryFillSpans(const QPoint& seed, bool eightConnected, const QBrush& boundaryBrush, const QBrush& fillBrush, QVector<SeedFill::Span>& spans);
 
     void addBoundaryPoint(const QPoint &cell);
 };
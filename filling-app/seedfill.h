@@ -0,0 +1,95 @@
+#ifndef SEEDFILL_H
+#define SEEDFILL_H
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+
+// Scanline seed fill (Smith 1979, Heckbert's Graphics Gems stack variant). Whole horizontal
+// runs are filled at once and only one seed per run of the neighbouring rows is pushed, so
+// the work is one inside() test per cell plus a little per run. The per-cell BFS needs a
+// queue entry, a neighbour list and a set insert for every cell.
+namespace SeedFill {
+
+struct Span {
+    int y, x0, x1;
+};
+
+// One bit per cell of a rectangle, row-major. Rows are not padded to whole words.
+class Bitmap {
+public:
+    explicit Bitmap(const QRect& rect)
+        : box(rect), bits((qint64(rect.width()) * rect.height() + 63) / 64, 0) {}
+
+    bool test(int x, int y) const {
+        const qint64 i = offset(x, y);
+        return (bits[int(i >> 6)] >> (i & 63)) & 1;
+    }
+
+    // sets x0..x1 of row y, a whole word at a time where the run covers one
+    void setRun(int y, int x0, int x1) {
+        qint64 i = offset(x0, y);
+        const qint64 end = i + (x1 - x0) + 1;
+        while (i < end) {
+            const int bit = int(i & 63);
+            const int n = int(qMin<qint64>(64 - bit, end - i));
+            bits[int(i >> 6)] |= (n == 64 ? ~quint64(0) : ((quint64(1) << n) - 1)) << bit;
+            i += n;
+        }
+    }
+
+private:
+    qint64 offset(int x, int y) const { return qint64(y - box.top()) * box.width() + (x - box.left()); }
+
+    QRect box;
+    QVector<quint64> bits;
+};
+
+// Fills the region of cells for which inside(x, y) holds, connected to `seed` within `bounds`.
+// With eightConnected, runs on the next row also connect through their corners. Each
+// maximal run of the region goes to span(y, x0, x1) once, in the order it is filled.
+// inside() must not depend on the fill's own output: filled cells are tracked here in a
+// Bitmap over `bounds`. Returns the number of cells filled.
+template <typename Inside, typename SpanOut>
+qint64 scanline(const QPoint& seed, const QRect& bounds, bool eightConnected, Inside&& inside, SpanOut&& span)
+{
+    if (!bounds.contains(seed) || !inside(seed.x(), seed.y())) return 0;
+
+    // Runs of inside cells are maximal, so a row's runs are disjoint and either wholly filled
+    // or not at all. One bit at any cell of a run settles the whole run.
+    Bitmap filled(bounds);
+
+    const int reach = eightConnected ? 1 : 0;
+    QVector<QPoint> stack;
+    stack.append(seed);
+    qint64 cells = 0;
+    while (!stack.isEmpty()) {
+        const QPoint s = stack.takeLast();
+        const int y = s.y();
+        if (filled.test(s.x(), y)) continue;
+
+        int x0 = s.x(), x1 = s.x();
+        while (x0 > bounds.left() && inside(x0 - 1, y)) --x0;
+        while (x1 < bounds.right() && inside(x1 + 1, y)) ++x1;
+
+        filled.setRun(y, x0, x1);
+        span(y, x0, x1);
+        cells += x1 - x0 + 1;
+
+        // one seed per unfilled run of the rows above and below that touches [x0 - reach, x1 + reach]
+        for (int ny : { y - 1, y + 1 }) {
+            if (ny < bounds.top() || ny > bounds.bottom()) continue;
+            const int from = qMax(bounds.left(), x0 - reach), to = qMin(bounds.right(), x1 + reach);
+            for (int x = from; x <= to; ++x) {
+                if (!inside(x, ny)) continue;
+                if (!filled.test(x, ny)) stack.append(QPoint(x, ny));
+                while (x < to && inside(x + 1, ny)) ++x;
+            }
+        }
+    }
+    return cells;
+}
+
+} // namespace SeedFill
+
+#endif // SEEDFILL_H
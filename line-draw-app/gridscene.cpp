@@ -1,6 +1,7 @@
 #include "gridscene.h"
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
+#include <algorithm>
 
 GridScene::GridScene(QObject* parent) : QGraphicsScene(parent) {
     setSceneRect(-5000, -5000, 10000, 10000);
@@ -29,6 +30,42 @@ void GridScene::paintCell(const QPoint& cell, const QBrush& brush) {
 }
 
 
+QRectF GridScene::cellRect(const QPoint& cell) const {
+    return QRectF(cell.x() * cellSize, cell.y() * cellSize, cellSize, cellSize);
+}
+
+
+void GridScene::setPreviewCells(const QVector<QPoint>& cells) {
+    QSet<QPoint> next(cells.begin(), cells.end());
+
+    // only cells that left or entered the preview need repainting
+    QVector<QPoint> changed;
+    for (const QPoint& cell : previewCells)
+        if (!next.contains(cell)) changed.append(cell);
+    for (const QPoint& cell : next)
+        if (!previewCells.contains(cell)) changed.append(cell);
+
+    previewCells.swap(next);
+
+    // one update per horizontal run, so a rotating line doesn't expose its whole bounding box
+    std::sort(changed.begin(), changed.end(), [](const QPoint& a, const QPoint& b) {
+        return a.y() < b.y() || (a.y() == b.y() && a.x() < b.x());
+    });
+    for (int i = 0; i < changed.size();) {
+        int j = i + 1;
+        while (j < changed.size() && changed[j].y() == changed[i].y() && changed[j].x() == changed[j - 1].x() + 1)
+            ++j;
+        update(QRectF(changed[i].x() * cellSize, changed[i].y() * cellSize, (j - i) * cellSize, cellSize));
+        i = j;
+    }
+}
+
+
+void GridScene::clearPreview() {
+    setPreviewCells({});
+}
+
+
 void GridScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         QPoint cell(qFloor(event->scenePos().x() / cellSize), qFloor(event->scenePos().y() / cellSize));
@@ -39,6 +76,17 @@ void GridScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
 }
 
 
+void GridScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
+    QPoint cell(qFloor(event->scenePos().x() / cellSize), qFloor(event->scenePos().y() / cellSize));
+    if (cell != hoverCell) {
+        hoverCell = cell;
+        emit cellHovered(cell);
+    }
+
+    QGraphicsScene::mouseMoveEvent(event);
+}
+
+
 void GridScene::drawBackground(QPainter* painter, const QRectF& rect) {
     painter->setRenderHint(QPainter::Antialiasing, false);
 
@@ -87,6 +135,20 @@ void GridScene::drawBackground(QPainter* painter, const QRectF& rect) {
 }
 
 
+void GridScene::drawForeground(QPainter* painter, const QRectF& rect) {
+    if (previewCells.isEmpty())
+        return;
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(previewBrush);
+    for (const QPoint& cell : previewCells) {
+        QRectF r = cellRect(cell);
+        if (rect.intersects(r))
+            painter->drawRect(r);
+    }
+}
+
+
 void GridScene::clearCells() {
     coloredCells.clear();
     update();
@@ -3,6 +3,7 @@
 
 #include <QGraphicsScene>
 #include <QPoint>
+#include <QSet>
 
 class GridScene : public QGraphicsScene {
     Q_OBJECT
@@ -12,17 +13,29 @@ public:
 
     void paintCell(const QPoint& cell, const QBrush& brush);
     void toggleCell(const QPoint& cell);
+    void setPreviewCells(const QVector<QPoint>& cells);
+    void clearPreview();
     void mousePressEvent(QGraphicsSceneMouseEvent* event);
 
 protected:
+    void mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
     void drawBackground(QPainter* painter, const QRectF& rect) override;
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
 
 private:
+    QRectF cellRect(const QPoint& cell) const;
+
     int cellSize = 10;
     QList<QPair<QPoint, QBrush>> coloredCells;
 
+    // rubber-band overlay, drawn above the committed cells and never mixed into them
+    QSet<QPoint> previewCells;
+    QBrush previewBrush = QBrush(QColor(0, 0, 255, 110));
+    QPoint hoverCell;
+
 signals:
     void cellClicked(QPoint cell);
+    void cellHovered(QPoint cell);
 
 public slots:
     void clearCells();
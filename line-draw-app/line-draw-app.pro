@@ -1,4 +1,4 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -12,6 +12,7 @@ SOURCES += \
     gridscene.cpp \
     gridview.cpp \
     gridwidget.cpp \
+    linebench.cpp \
     main.cpp \
     mainwindow.cpp \
     my_label.cpp
@@ -19,6 +20,8 @@ SOURCES += \
 HEADERS += \
     gridscene.h \
     gridview.h \
+    linebench.h \
+    linekernel.h \
     gridwidget.h \
     mainwindow.h \
     my_label.h
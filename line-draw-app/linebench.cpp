@@ -0,0 +1,245 @@
+#include "linebench.h"
+#include <QElapsedTimer>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+using Segment = QPair<QPoint, QPoint>;
+
+// Keeps the calling thread on the CPU it is running on until it goes out of scope.
+// Migrations between cores with different clocks or cold caches would otherwise add to the
+// spread of the timings.
+class ThreadPin {
+public:
+    ThreadPin()
+    {
+#if defined(Q_OS_WIN)
+        const DWORD current = GetCurrentProcessorNumber();
+        if (current < sizeof(DWORD_PTR) * 8) {
+            oldMask = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << current);
+            if (oldMask) cpu = int(current);
+        }
+#elif defined(Q_OS_LINUX)
+        const int current = sched_getcpu();
+        if (current >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(oldSet), &oldSet) == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(current, &one);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(one), &one) == 0) cpu = current;
+        }
+#endif
+    }
+
+    ~ThreadPin()
+    {
+        if (cpu < 0) return;
+#if defined(Q_OS_WIN)
+        SetThreadAffinityMask(GetCurrentThread(), oldMask);
+#elif defined(Q_OS_LINUX)
+        pthread_setaffinity_np(pthread_self(), sizeof(oldSet), &oldSet);
+#endif
+    }
+
+    int cpu = -1;
+
+private:
+#if defined(Q_OS_WIN)
+    DWORD_PTR oldMask = 0;
+#elif defined(Q_OS_LINUX)
+    cpu_set_t oldSet;
+#endif
+};
+
+// Two-sided 95% quantile of Student's t for 1..30 degrees of freedom; the normal value
+// is close enough past that.
+double tQuantile95(int df)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return 0.0;
+    return df <= 30 ? table[df - 1] : 1.960;
+}
+
+LineBenchmark::Stat summarise(const QVector<double>& samples)
+{
+    LineBenchmark::Stat s;
+    const int n = samples.size();
+    if (n == 0) return s;
+
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    s.mean = sum / n;
+    if (n < 2) return s;
+
+    double sq = 0.0;
+    for (double v : samples) sq += (v - s.mean) * (v - s.mean);
+    s.ci95 = tQuantile95(n - 1) * std::sqrt(sq / (n - 1)) / std::sqrt(double(n));
+    return s;
+}
+
+qint64 runBatch(const LineBenchmark::LineFn& fn, const QVector<Segment>& segments)
+{
+    // fold the output into a checksum so the calls cannot be optimised away
+    qint64 sum = 0;
+    for (const Segment& s : segments) {
+        const QVector<QPoint> pts = fn(s.first, s.second);
+        sum += pts.size();
+        if (!pts.isEmpty()) sum += pts.last().x();
+    }
+    return sum;
+}
+
+} // namespace
+
+void LineBenchmark::addAlgorithm(const QString& name, LineFn fn)
+{
+    algorithms.append({ name, std::move(fn) });
+}
+
+void LineBenchmark::addDisagreementPair(int a, int b)
+{
+    pairs.append({ a, b });
+}
+
+QStringList LineBenchmark::algorithmNames() const
+{
+    QStringList names;
+    for (const Algorithm& a : algorithms) names << a.name;
+    return names;
+}
+
+QStringList LineBenchmark::disagreementNames() const
+{
+    QStringList names;
+    for (const QPair<int, int>& p : pairs) names << algorithms[p.first].name + " vs " + algorithms[p.second].name;
+    return names;
+}
+
+QVector<LineBenchmark::Row> LineBenchmark::run(int segmentsPerDecade, int repetitions)
+{
+    const int decades = 5;                // 1..10^5
+    const qint64 targetNs = 1000000;      // each timed sample runs for at least 1 ms
+    const int n = algorithms.size();
+    reps = qMax(2, repetitions);
+
+    QVector<Row> rows;
+    if (n == 0 || segmentsPerDecade <= 0) return rows;
+
+    // Fixed seed, so every algorithm and every run sees the same segments. Octants are taken
+    // round-robin, and lengths are log-uniform within each decade.
+    QRandomGenerator rng(20240217);
+    QVector<QVector<Segment>> buckets(decades);
+    for (int d = 0; d < decades; ++d) {
+        for (int i = 0; i < segmentsPerDecade; ++i) {
+            const int major = qBound(1, int(std::pow(10.0, d + rng.generateDouble())), 100000);
+            const int minor = rng.bounded(major + 1);
+            const int octant = i % 8;
+            const int sx = (octant & 2) ? 1 : -1;
+            const int sy = (octant & 1) ? 1 : -1;
+            const QPoint p1(rng.bounded(-500, 500), rng.bounded(-500, 500));
+            const QPoint delta = (octant & 4) ? QPoint(sx * major, sy * minor)
+                                              : QPoint(sx * minor, sy * major);
+            buckets[d].append({ p1, p1 + delta });
+        }
+    }
+
+    // pixel counts and disagreements come from untimed runs
+    for (int i = pairs.size() - 1; i >= 0; --i) {
+        const QPair<int, int>& p = pairs[i];
+        if (p.first == p.second || p.first < 0 || p.second < 0 || p.first >= n || p.second >= n)
+            pairs.remove(i);
+    }
+    rows.resize(decades + 1);
+    for (Row& row : rows) row.disagreements.fill(0, pairs.size());
+    for (int d = 0; d < decades; ++d) {
+        Row& row = rows[d];
+        const int lo = int(std::pow(10.0, d));
+        row.label = QString("%1 - %2").arg(lo).arg(d == decades - 1 ? lo * 10 : lo * 10 - 1);
+        row.segments = buckets[d].size();
+        for (const Segment& s : buckets[d]) {
+            const QVector<QPoint> ref = algorithms[0].fn(s.first, s.second);
+            row.pixels += ref.size();
+            for (int p = 0; p < pairs.size(); ++p) {
+                const QVector<QPoint> a = algorithms[pairs[p].first].fn(s.first, s.second);
+                const QVector<QPoint> b = algorithms[pairs[p].second].fn(s.first, s.second);
+                const int common = qMin(a.size(), b.size());
+                for (int i = 0; i < common; ++i)
+                    if (a[i] != b[i]) ++row.disagreements[p];
+                row.disagreements[p] += qAbs(a.size() - b.size());
+            }
+        }
+        rows[decades].segments += row.segments;
+        rows[decades].pixels += row.pixels;
+        for (int p = 0; p < pairs.size(); ++p)
+            rows[decades].disagreements[p] += row.disagreements[p];
+    }
+    rows[decades].label = "All";
+
+    ThreadPin pin;
+    cpu = pin.cpu;
+    qint64 checksum = 0;
+
+    // Warm caches, the allocator and the branch predictors. Then size each decade's inner
+    // loop so that even the fastest algorithm's sample is long enough to time.
+    QVector<int> inner(decades, 1);
+    for (int d = 0; d < decades; ++d) {
+        qint64 fastest = -1;
+        for (int a = 0; a < n; ++a) {
+            for (int w = 0; w < 3; ++w) checksum += runBatch(algorithms[a].fn, buckets[d]);
+            QElapsedTimer timer;
+            timer.start();
+            checksum += runBatch(algorithms[a].fn, buckets[d]);
+            const qint64 ns = qMax<qint64>(1, timer.nsecsElapsed());
+            if (fastest < 0 || ns < fastest) fastest = ns;
+        }
+        inner[d] = int(qBound<qint64>(1, (targetNs + fastest - 1) / fastest, 1000000));
+    }
+
+    // samples[d][a][r] is ns/pixel for decade d, algorithm a, repetition r. Each repetition
+    // rotates the algorithm order so slow drift (thermal, frequency) is not pinned on one.
+    QVector<QVector<QVector<double>>> samples(decades, QVector<QVector<double>>(n));
+    QVector<QVector<double>> totalNs(n, QVector<double>(reps, 0.0));
+    for (int r = 0; r < reps; ++r) {
+        for (int d = 0; d < decades; ++d) {
+            for (int k = 0; k < n; ++k) {
+                const int a = (r + k) % n;
+                QElapsedTimer timer;
+                timer.start();
+                for (int i = 0; i < inner[d]; ++i)
+                    checksum += runBatch(algorithms[a].fn, buckets[d]);
+                const double perBatch = double(timer.nsecsElapsed()) / inner[d];
+                samples[d][a].append(perBatch / qMax<qint64>(1, rows[d].pixels));
+                totalNs[a][r] += perBatch;
+            }
+        }
+    }
+
+    for (int d = 0; d < decades; ++d)
+        for (int a = 0; a < n; ++a)
+            rows[d].nsPerPixel.append(summarise(samples[d][a]));
+
+    // the "All" row weights every pixel equally, so the long lines dominate it
+    for (int a = 0; a < n; ++a) {
+        QVector<double> perPixel;
+        for (double ns : totalNs[a]) perPixel.append(ns / qMax<qint64>(1, rows[decades].pixels));
+        rows[decades].nsPerPixel.append(summarise(perPixel));
+    }
+
+    static volatile qint64 sink;
+    sink = checksum;
+    return rows;
+}
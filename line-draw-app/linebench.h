@@ -0,0 +1,54 @@
+#ifndef LINEBENCH_H
+#define LINEBENCH_H
+
+#include <QPair>
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+// Times line rasterisers on one fixed set of random segments. The segments cover all eight
+// octants, with major-axis lengths from 1 to 10^5 grouped by decade. Results are ns per
+// pixel with a 95% confidence interval taken over repeated timed runs.
+class LineBenchmark {
+public:
+    using LineFn = std::function<QVector<QPoint>(QPoint, QPoint)>;
+
+    struct Stat {
+        double mean = 0;    // ns per pixel
+        double ci95 = 0;    // half-width of the 95% confidence interval
+    };
+
+    struct Row {
+        QString label;
+        int segments = 0;
+        qint64 pixels = 0;                  // cells per segment summed, as drawn by the first algorithm
+        QVector<qint64> disagreements;      // cells where each disagreement pair differ
+        QVector<Stat> nsPerPixel;           // one per algorithm, in the order they were added
+    };
+
+    void addAlgorithm(const QString& name, LineFn fn);
+    void addDisagreementPair(int a, int b);
+
+    // One row per length decade followed by an "All" row over every segment.
+    QVector<Row> run(int segmentsPerDecade = 64, int repetitions = 15);
+
+    QStringList algorithmNames() const;
+    QStringList disagreementNames() const;  // "A vs B", one per pair
+    int pinnedCpu() const { return cpu; }   // -1 when the thread could not be pinned
+    int repetitions() const { return reps; }
+
+private:
+    struct Algorithm {
+        QString name;
+        LineFn fn;
+    };
+
+    QVector<Algorithm> algorithms;
+    QVector<QPair<int, int>> pairs;
+    int cpu = -1;
+    int reps = 0;
+};
+
+#endif // LINEBENCH_H
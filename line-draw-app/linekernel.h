@@ -0,0 +1,136 @@
+#ifndef LINEKERNEL_H
+#define LINEKERNEL_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstdlib>
+
+// Bresenham line kernels specialised at compile time for the major axis and the step signs.
+// The octant is resolved once per segment, so the inner loop has a fixed trip count and a
+// single branch on the decision variable instead of the generic loop's two error tests plus
+// the endpoint test. Cells come out in the same order and positions as the generic
+// sx/sy/err loop, ties included.
+namespace LineKernel {
+
+template <bool XMajor, int SX, int SY, typename Plot>
+inline void walk(int x, int y, qint64 major, qint64 minor, qint64 count, qint64 d, Plot& plot)
+{
+    const qint64 incStraight = 2 * minor;
+    const qint64 incDiagonal = 2 * minor - 2 * major;
+    for (qint64 i = 0; i < count; ++i) {
+        plot(x, y);
+        if (XMajor) x += SX; else y += SY;
+        if (d > 0) {
+            if (XMajor) y += SY; else x += SX;
+            d += incDiagonal;
+        } else {
+            d += incStraight;
+        }
+    }
+}
+
+// Plot cells first..last (0-based, along the major axis) of the line p1 -> p2. The state at
+// `first` is computed in closed form, so a clipped range yields exactly the cells the full
+// line would have produced there.
+template <typename Plot>
+void bresenhamRange(const QPoint& p1, const QPoint& p2, qint64 first, qint64 last, Plot&& plot)
+{
+    const qint64 dx = std::abs(qint64(p2.x()) - p1.x()), dy = std::abs(qint64(p2.y()) - p1.y());
+    const bool xMajor = dx >= dy;
+    const qint64 major = xMajor ? dx : dy, minor = xMajor ? dy : dx;
+    first = std::max<qint64>(first, 0);
+    last = std::min<qint64>(last, major);
+    if (first > last) return;
+
+    // minor-axis cells taken before step `first`, and the decision variable at that step
+    const qint64 j = major ? (2 * first * minor + major - 1) / (2 * major) : 0;
+    const qint64 d = 2 * (first + 1) * minor - (2 * j + 1) * major;
+    const int sx = (p1.x() < p2.x()) ? 1 : -1;
+    const int sy = (p1.y() < p2.y()) ? 1 : -1;
+    const int x = int(p1.x() + sx * (xMajor ? first : j));
+    const int y = int(p1.y() + sy * (xMajor ? j : first));
+    const qint64 count = last - first + 1;
+
+    switch ((xMajor ? 4 : 0) | (sx > 0 ? 2 : 0) | (sy > 0 ? 1 : 0)) {
+    case 7: walk<true,   1,  1>(x, y, major, minor, count, d, plot); break;
+    case 6: walk<true,   1, -1>(x, y, major, minor, count, d, plot); break;
+    case 5: walk<true,  -1,  1>(x, y, major, minor, count, d, plot); break;
+    case 4: walk<true,  -1, -1>(x, y, major, minor, count, d, plot); break;
+    case 3: walk<false,  1,  1>(x, y, major, minor, count, d, plot); break;
+    case 2: walk<false,  1, -1>(x, y, major, minor, count, d, plot); break;
+    case 1: walk<false, -1,  1>(x, y, major, minor, count, d, plot); break;
+    default: walk<false, -1, -1>(x, y, major, minor, count, d, plot); break;
+    }
+}
+
+// Plot every cell of the line p1 -> p2, endpoints included.
+template <typename Plot>
+void bresenham(const QPoint& p1, const QPoint& p2, Plot&& plot)
+{
+    const qint64 steps = std::max(std::abs(qint64(p2.x()) - p1.x()), std::abs(qint64(p2.y()) - p1.y()));
+    bresenhamRange(p1, p2, 0, steps, plot);
+}
+
+// Plot the cells of the polyline through `pts` once each. Segments after the first start
+// one step in, so a shared vertex is not plotted twice, and repeated vertices are dropped.
+// Consecutive collinear segments that head the same way are walked as one line. An integer
+// vertex on that line is a cell Bresenham lands on exactly, so the cells do not change.
+// When `closed`, the closing edge stops one step short of the first vertex. Only places
+// where the polyline crosses or doubles back on itself are plotted more than once.
+// Returns the number of cells plotted.
+template <typename Points, typename Plot>
+qint64 polyline(const Points& pts, bool closed, Plot&& plot)
+{
+    const int n = pts.size();
+    if (n == 0) return 0;
+
+    qint64 count = 0;
+    auto counted = [&](int x, int y) { plot(x, y); ++count; };
+    auto walkRun = [&](const QPoint& a, const QPoint& b, bool skipFirst, bool skipLast) {
+        const qint64 steps = std::max(std::abs(qint64(b.x()) - a.x()), std::abs(qint64(b.y()) - a.y()));
+        bresenhamRange(a, b, skipFirst ? 1 : 0, skipLast ? steps - 1 : steps, counted);
+    };
+
+    QPoint start = pts[0], end = pts[0];
+    bool started = false;
+    for (int i = 1; i < (closed ? n + 1 : n); ++i) {
+        const QPoint& p = pts[i % n];
+        if (p == end) continue;
+        if (end != start) {
+            const qint64 ux = end.x() - start.x(), uy = end.y() - start.y();
+            const qint64 vx = p.x() - end.x(), vy = p.y() - end.y();
+            if (ux * vy == uy * vx && ux * vx + uy * vy > 0) { end = p; continue; }
+            walkRun(start, end, started, false);
+            started = true;
+            start = end;
+        }
+        end = p;
+    }
+
+    if (end != start)
+        walkRun(start, end, started, closed && started && end == pts[0]);
+    else if (!started)
+        counted(start.x(), start.y());
+    return count;
+}
+
+// Cells written when every segment of the polyline is drawn on its own, with endpoints
+// included. This is the baseline polyline() is measured against.
+template <typename Points>
+qint64 segmentWrites(const Points& pts, bool closed)
+{
+    const int n = pts.size();
+    if (n < 2) return n;
+    qint64 writes = 0;
+    for (int i = 0; i < (closed ? n : n - 1); ++i) {
+        const QPoint& a = pts[i];
+        const QPoint& b = pts[(i + 1) % n];
+        writes += std::max(std::abs(qint64(b.x()) - a.x()), std::abs(qint64(b.y()) - a.y())) + 1;
+    }
+    return writes;
+}
+
+} // namespace LineKernel
+
+#endif // LINEKERNEL_H
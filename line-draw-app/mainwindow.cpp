@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
@@ -8,6 +9,14 @@
 #include <QDebug>
 #include <QLabel>
 #include <QWidget>
+#include <QApplication>
+#include <QDialog>
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QCheckBox>
+#include <QThread>
+#include <QtConcurrent>
+#include <numeric>
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     QWidget *central = new QWidget;
@@ -16,6 +25,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     scene = new GridScene(this);
     view = new GridView;
     view->setScene(scene);
+    view->setMouseTracking(true);
     scene->setSceneRect(-500, -500, 1000, 1000);
 
     labelP1 = new QLabel("P1: ( , )");
@@ -25,12 +35,15 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     btnDrawBres = new QPushButton("Bresenham Line");
     btnClear = new QPushButton("Clear");
     btnCompare = new QPushButton("Compare");
+    chkParallel = new QCheckBox("Parallel");
+    chkParallel->setToolTip("Split long Bresenham lines across the thread pool");
 
     QHBoxLayout *controls = new QHBoxLayout;
     controls->addWidget(labelP1);
     controls->addWidget(labelP2);
     controls->addWidget(btnDrawDDA);
     controls->addWidget(btnDrawBres);
+    controls->addWidget(chkParallel);
     controls->addWidget(btnClear);
     controls->addWidget(btnCompare);
 
@@ -40,6 +53,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     setCentralWidget(central);
 
     connect(scene, &GridScene::cellClicked, this, &MainWindow::onCellClicked);
+    connect(scene, &GridScene::cellHovered, this, &MainWindow::onCellHovered);
     connect(btnDrawDDA, &QPushButton::clicked, this, &MainWindow::drawLineDDA);
     connect(btnDrawBres, &QPushButton::clicked, this, &MainWindow::drawLineBresenham);
     connect(btnClear, &QPushButton::clicked, this, &MainWindow::clearGrid);
@@ -56,10 +70,18 @@ void MainWindow::onCellClicked(QPoint pos) {
         point2 = pos;
         labelP2->setText(QString("P2: (%1, %2)").arg(pos.x()).arg(pos.y()));
         hasFirstPoint = false;
+        scene->clearPreview();
         scene->paintCell(point2, QBrush(Qt::black));
     }
 }
 
+void MainWindow::onCellHovered(QPoint pos) {
+    // rubber band from P1 to the cursor while waiting for the second click
+    if (!hasFirstPoint)
+        return;
+    scene->setPreviewCells(computeBresenhamLine(point1, pos));
+}
+
 QVector<QPoint> MainWindow::computeDDALine(QPoint p1, QPoint p2) {
     QVector<QPoint> points;
 
@@ -82,6 +104,44 @@ QVector<QPoint> MainWindow::computeDDALine(QPoint p1, QPoint p2) {
 
 QVector<QPoint> MainWindow::computeBresenhamLine(QPoint p1, QPoint p2) {
     QVector<QPoint> points;
+    points.reserve(std::max(abs(p2.x() - p1.x()), abs(p2.y() - p1.y())) + 1);
+    LineKernel::bresenham(p1, p2, [&](int x, int y) {
+        points.append(QPoint(x, y));
+    });
+    return points;
+}
+
+// Long lines are cut into contiguous step ranges, one per pool thread. bresenhamRange starts
+// each range from its closed-form state, so every chunk writes exactly the cells the serial
+// walk would into its own slice of the output. Lines too short to repay the thread hand-off
+// stay serial.
+QVector<QPoint> MainWindow::computeBresenhamLineParallel(QPoint p1, QPoint p2) {
+    const qint64 minChunkSteps = 1 << 14;
+    const qint64 cells = qint64(std::max(abs(p2.x() - p1.x()), abs(p2.y() - p1.y()))) + 1;
+    const int chunks = int(std::min<qint64>(QThread::idealThreadCount(), cells / minChunkSteps));
+    if (chunks < 2)
+        return computeBresenhamLine(p1, p2);
+
+    QVector<QPoint> points(int(cells));
+    QPoint *out = points.data();
+    QVector<int> ids(chunks);
+    std::iota(ids.begin(), ids.end(), 0);
+    QtConcurrent::blockingMap(ids, [&](int k) {
+        const qint64 first = cells * k / chunks;
+        const qint64 last = cells * (k + 1) / chunks - 1;
+        QPoint *dst = out + first;
+        LineKernel::bresenhamRange(p1, p2, first, last, [&](int x, int y) {
+            *dst++ = QPoint(x, y);
+        });
+    });
+    return points;
+}
+
+// The single-loop Bresenham that handles every octant at run time, kept as the baseline the
+// octant-specialised kernel is timed against.
+QVector<QPoint> MainWindow::computeBresenhamLineGeneric(QPoint p1, QPoint p2) {
+    QVector<QPoint> points;
+    points.reserve(std::max(abs(p2.x() - p1.x()), abs(p2.y() - p1.y())) + 1);
 
     int x1 = p1.x(), y1 = p1.y();
     int x2 = p2.x(), y2 = p2.y();
@@ -111,62 +171,76 @@ void MainWindow::drawLineDDA() {
 }
 
 void MainWindow::drawLineBresenham() {
-    auto points = computeBresenhamLine(point1, point2);
+    auto points = chkParallel->isChecked() ? computeBresenhamLineParallel(point1, point2)
+                                           : computeBresenhamLine(point1, point2);
     for (auto &pt : points)
         scene->paintCell(pt, QBrush(Qt::blue));
 }
 
-qreal MainWindow::computeAvgDDAtime(int num_iters) {
-    qint64 totalTimeDDA = 0;
-
-    // qDebug() << "DDA time each iter:\n";
-    for (int iter=0; iter < num_iters; iter++) {
-        QElapsedTimer timer;
-
-        timer.start();
-        volatile auto ddaPoints = computeDDALine(point1, point2);
-        // qDebug() << "iter " << iter+1 << ": " << timer.nsecsElapsed() << "ns\n";
-        totalTimeDDA += timer.nsecsElapsed();
-    }
-
-    // qDebug() << "DDA total time for 50 iters: " << totalTimeDDA << "ns\n";
-
-    return totalTimeDDA / num_iters;
-}
-
-qreal MainWindow::computeAvgBresenhamtime(int num_iters) {
-    qint64 totalTimeBresenham = 0;
-
-    // qDebug() << "Bresenham time each iter:\n";
-    for (int iter=0; iter < num_iters; iter++) {
-        QElapsedTimer timer;
-
-        timer.start();
-        volatile auto bresPoints = computeBresenhamLine(point1, point2);
-        // qDebug() << "iter " << iter+1 << ": " << timer.nsecsElapsed() << "ns\n";
-        totalTimeBresenham += timer.nsecsElapsed();
+void MainWindow::compareAlgorithms() {
+    LineBenchmark bench;
+    bench.addAlgorithm("DDA", [this](QPoint a, QPoint b) { return computeDDALine(a, b); });
+    bench.addAlgorithm("Bresenham", [this](QPoint a, QPoint b) { return computeBresenhamLine(a, b); });
+    bench.addAlgorithm("Bresenham (generic)", [this](QPoint a, QPoint b) { return computeBresenhamLineGeneric(a, b); });
+    bench.addAlgorithm("Bresenham (parallel)", [this](QPoint a, QPoint b) { return computeBresenhamLineParallel(a, b); });
+    bench.addDisagreementPair(0, 1);
+    bench.addDisagreementPair(1, 3);
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const QVector<LineBenchmark::Row> rows = bench.run();
+    QApplication::restoreOverrideCursor();
+
+    for (const LineBenchmark::Row& row : rows) {
+        qDebug() << "Length" << row.label << "pixels" << row.pixels << "differing" << bench.disagreementNames() << row.disagreements;
+        for (int a = 0; a < row.nsPerPixel.size(); ++a)
+            qDebug() << "   " << bench.algorithmNames().at(a) << row.nsPerPixel[a].mean << "+/-" << row.nsPerPixel[a].ci95 << "ns/pixel";
     }
 
-    // qDebug() << "Bresenham total time for 50 iters: " << totalTimeBresenham << "ns\n";
-    return totalTimeBresenham / num_iters;
+    showComparison(bench, rows);
 }
 
-void MainWindow::compareAlgorithms() {
-    qreal avgDDAtime = computeAvgDDAtime(10);
-    qreal avgBresenhamtime = computeAvgBresenhamtime(10);
-
-    qDebug() << "Average time (DDA):" << avgDDAtime << "ns";
-    qDebug() << "Average time (Bresenham):" << avgBresenhamtime << "ns";
-
-    if (avgDDAtime > avgBresenhamtime) {
-        qDebug() << "Bresenham is faster by " << avgDDAtime - avgBresenhamtime << "ns";
-    }
-    else if (avgDDAtime < avgBresenhamtime) {
-        qDebug() << "DDA is faster by " << avgBresenhamtime - avgDDAtime << "ns";
-    }
-    else {
-        qDebug() << "Both performed equally";
+void MainWindow::showComparison(const LineBenchmark& bench, const QVector<LineBenchmark::Row>& rows) {
+    const QStringList names = bench.algorithmNames();
+
+    QStringList headers = { "Length", "Segments", "Pixels" };
+    for (const QString& name : names)
+        headers << name + " ns/px";
+    for (const QString& pair : bench.disagreementNames())
+        headers << pair + " differing px";
+
+    QTableWidget *table = new QTableWidget(rows.size(), headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    for (int r = 0; r < rows.size(); ++r) {
+        const LineBenchmark::Row& row = rows[r];
+        int c = 0;
+        table->setItem(r, c++, new QTableWidgetItem(row.label));
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.segments)));
+        table->setItem(r, c++, new QTableWidgetItem(QString::number(row.pixels)));
+        for (const LineBenchmark::Stat& s : row.nsPerPixel)
+            table->setItem(r, c++, new QTableWidgetItem(QString("%1 +/- %2").arg(s.mean, 0, 'f', 3).arg(s.ci95, 0, 'f', 3)));
+        for (qint64 differing : row.disagreements) {
+            const double pct = row.pixels ? 100.0 * differing / row.pixels : 0.0;
+            table->setItem(r, c++, new QTableWidgetItem(QString("%1 (%2%)").arg(differing).arg(pct, 0, 'f', 1)));
+        }
     }
+    table->resizeColumnsToContents();
+
+    QString pinned = bench.pinnedCpu() >= 0 ? QString("pinned to CPU %1").arg(bench.pinnedCpu()) : QString("not pinned");
+    QLabel *summary = new QLabel(QString("Random segments over all 8 octants, mean +/- 95% confidence interval "
+                                         "over %1 timed repetitions after warm-up; thread %2.")
+                                     .arg(bench.repetitions()).arg(pinned));
+    summary->setWordWrap(true);
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Line algorithm comparison");
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    layout->addWidget(summary);
+    layout->addWidget(table);
+    dialog.resize(900, 320);
+    dialog.exec();
 }
 
 void MainWindow::clearGrid() {
@@ -177,6 +251,8 @@ void MainWindow::clearGrid() {
     }
 
     scene->clearCells();
+    scene->clearPreview();
+    hasFirstPoint = false;
     labelP1->setText("P1: ( , )");
     labelP2->setText("P2: ( , )");
 }
@@ -5,11 +5,13 @@
 #include <QPoint>
 #include <QGraphicsItem>
 #include <QVector>
+#include "linebench.h"
 
 class GridScene;
 class GridView;
 class QLabel;
 class QPushButton;
+class QCheckBox;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -19,16 +21,19 @@ public:
 
 private slots:
     void onCellClicked(QPoint pos);
+    void onCellHovered(QPoint pos);
     QVector<QPoint> computeDDALine(QPoint p1, QPoint p2);
     QVector<QPoint> computeBresenhamLine(QPoint p1, QPoint p2);
+    QVector<QPoint> computeBresenhamLineGeneric(QPoint p1, QPoint p2);
+    QVector<QPoint> computeBresenhamLineParallel(QPoint p1, QPoint p2);
     void drawLineDDA();
     void drawLineBresenham();
-    qreal computeAvgDDAtime(int num_iters);
-    qreal computeAvgBresenhamtime(int num_iters);
     void compareAlgorithms();
     void clearGrid();
 
 private:
+    void showComparison(const LineBenchmark& bench, const QVector<LineBenchmark::Row>& rows);
+
     GridScene* scene;
     GridView* view;
     QLabel* labelP1;
@@ -37,13 +42,11 @@ private:
     QPushButton* btnDrawBres;
     QPushButton* btnClear;
     QPushButton* btnCompare;
+    QCheckBox* chkParallel;
 
     QPoint point1, point2;
     bool hasFirstPoint = false;
     QGraphicsItem* line = nullptr;
-
-    double avgTimeDDA = 0;
-    double avgTimeBres = 0;
 };
 
 #endif // MAINWINDOW_H
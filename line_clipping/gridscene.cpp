@@ -18,6 +18,11 @@ void GridScene::paintCell(const QPoint& cell, const QBrush& brush) {
     }
 }
 
+void GridScene::paintSpan(int y, int x0, int x1, const QBrush& brush) {
+    for (int x = x0; x <= x1; ++x)
+        paintCell(QPoint(x, y), brush);
+}
+
 void GridScene::clearCells() {
     for (auto *item : cellItems) removeItem(item);
     qDeleteAll(cellItems);
@@ -2,19 +2,146 @@
 #include "ui_mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 #include <QMessageBox>
 #include <cmath>
 #include <algorithm>
 
+// Cell (x, y) is covered when its centre lies inside the polygon; the test is half-open
+// ([top, bottom) and [left, right)) so polygons sharing an edge never both claim a cell.
+static void scanPolygonSpans(const QVector<QPointF>& poly, QVector<CellSpan>& spans)
+{
+    const int n = poly.size();
+    if (n < 3) return;
+
+    double yMin = poly[0].y(), yMax = poly[0].y();
+    for (const QPointF& p : poly) {
+        yMin = std::min(yMin, p.y());
+        yMax = std::max(yMax, p.y());
+    }
+
+    for (int y = int(std::ceil(yMin)); y < yMax; ++y) {
+        double xl = 0.0, xr = 0.0;
+        bool hit = false;
+        for (int i = 0; i < n; ++i) {
+            const QPointF& a = poly[i];
+            const QPointF& b = poly[(i + 1) % n];
+            if ((a.y() <= y) == (b.y() <= y)) continue;
+            double x = a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+            if (!hit) { xl = xr = x; hit = true; }
+            else { xl = std::min(xl, x); xr = std::max(xr, x); }
+        }
+        int x0 = int(std::ceil(xl)), x1 = int(std::ceil(xr)) - 1;
+        if (hit && x0 <= x1) spans.append({y, x0, x1});
+    }
+}
+
+// Stroke a polyline of the given width: each segment becomes a quad whose ends are mitred
+// against its neighbours (bevelled past the mitre limit) or capped at open ends, and the
+// per-row spans of all quads are merged so the covered area is emitted once.
+static QVector<CellSpan> strokeSpans(const QVector<QPointF>& points, double width, LineCap cap, bool closed)
+{
+    QVector<CellSpan> spans;
+    if (points.isEmpty() || width <= 0.0) return spans;
+
+    QVector<QPointF> v;
+    for (const QPointF& p : points)
+        if (v.isEmpty() || p != v.last()) v.append(p);
+    if (v.size() > 1 && v.first() == v.last()) v.removeLast();
+    if (v.size() < 3) closed = false;
+
+    const double hw = width / 2.0;
+    const double miterLimit = 4.0;  // max mitre length, in half-widths
+
+    if (v.size() == 1) {
+        if (cap == SquareCap) {
+            const QPointF& c = v[0];
+            scanPolygonSpans({ {c.x() - hw, c.y() - hw}, {c.x() + hw, c.y() - hw},
+                               {c.x() + hw, c.y() + hw}, {c.x() - hw, c.y() + hw} }, spans);
+        }
+        return spans;
+    }
+
+    const int n = v.size();
+    const int segCount = closed ? n : n - 1;
+    QVector<QPointF> dir(segCount), nrm(segCount);
+    for (int i = 0; i < segCount; ++i) {
+        QPointF d = v[(i + 1) % n] - v[i];
+        double len = std::sqrt(d.x() * d.x() + d.y() * d.y());
+        dir[i] = d / len;
+        nrm[i] = QPointF(-dir[i].y(), dir[i].x());
+    }
+
+    // Offset of the join between segments a and b (a entering, b leaving the shared vertex),
+    // or false when the mitre would exceed the limit and a bevel is needed instead.
+    auto miterOffset = [&](int a, int b, QPointF& offset) {
+        QPointF m = nrm[a] + nrm[b];
+        double len2 = m.x() * m.x() + m.y() * m.y();
+        if (len2 * miterLimit * miterLimit < 4.0) return false;
+        offset = m * (2.0 * hw / len2);
+        return true;
+    };
+
+    for (int i = 0; i < segCount; ++i) {
+        const QPointF& a = v[i];
+        const QPointF& b = v[(i + 1) % n];
+        QPointF aL = a + nrm[i] * hw, aR = a - nrm[i] * hw;
+        QPointF bL = b + nrm[i] * hw, bR = b - nrm[i] * hw;
+        QPointF offset;
+
+        if (closed || i > 0) {
+            int prev = (i + segCount - 1) % segCount;
+            if (miterOffset(prev, i, offset)) {
+                aL = a + offset;
+                aR = a - offset;
+            } else {
+                scanPolygonSpans({ a, a + nrm[prev] * hw, aL }, spans);
+                scanPolygonSpans({ a, a - nrm[prev] * hw, aR }, spans);
+            }
+        } else if (cap == SquareCap) {
+            aL = aL - dir[i] * hw;
+            aR = aR - dir[i] * hw;
+        }
+
+        if (closed || i < segCount - 1) {
+            int next = (i + 1) % segCount;
+            if (miterOffset(i, next, offset)) {
+                bL = b + offset;
+                bR = b - offset;
+            }
+        } else if (cap == SquareCap) {
+            bL = bL + dir[i] * hw;
+            bR = bR + dir[i] * hw;
+        }
+
+        scanPolygonSpans({ aL, bL, bR, aR }, spans);
+    }
+
+    std::sort(spans.begin(), spans.end(), [](const CellSpan& l, const CellSpan& r) {
+        return l.y < r.y || (l.y == r.y && l.x0 < r.x0);
+    });
+    QVector<CellSpan> merged;
+    for (const CellSpan& s : spans) {
+        if (!merged.isEmpty() && merged.last().y == s.y && s.x0 <= merged.last().x1 + 1)
+            merged.last().x1 = std::max(merged.last().x1, s.x1);
+        else
+            merged.append(s);
+    }
+    return merged;
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new GridScene(this))
     , isDrawingLine(false)
     , lineClickCount(0)
+    , lineWidth(1)
+    , lineCap(SquareCap)
     , hasClippingWindow(false)
     , isDrawingWindow(false)
     , windowClickCount(0)
+    , windowBorder(1)
 {
     ui->setupUi(this);
     ui->grid->setScene(scene);
@@ -47,7 +174,9 @@ void MainWindow::onCellClicked(const QPoint& cell)
         scene->paintCell(cell, QBrush(Qt::blue));
 
         if (lineClickCount == 2) {
-            bresenhamLine(linePoints[0], linePoints[1], QBrush(Qt::blue));
+            lineWidth = ui->strokeWidth->value();
+            lineCap = static_cast<LineCap>(ui->lineCap->currentIndex());
+            drawThickLine(linePoints[0], linePoints[1], QBrush(Qt::blue), lineWidth, lineCap);
             originalLinePoints = linePoints;
             isDrawingLine = false;
             lineClickCount = 0;
@@ -67,9 +196,10 @@ void MainWindow::onCellClicked(const QPoint& cell)
             int yMax = std::max(windowStart.y(), cell.y());
 
             clippingWindow = QRect(QPoint(xMin, yMin), QPoint(xMax, yMax));
+            windowBorder = ui->strokeWidth->value();
 
             fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-            drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+            drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
 
             hasClippingWindow = true;
             isDrawingWindow = false;
@@ -117,10 +247,10 @@ void MainWindow::onRestoreLine()
 
     if (hasClippingWindow) {
         fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-        drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+        drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
     }
 
-    bresenhamLine(linePoints[0], linePoints[1], QBrush(Qt::blue));
+    drawThickLine(linePoints[0], linePoints[1], QBrush(Qt::blue), lineWidth, lineCap);
     scene->update();
 }
 
@@ -167,7 +297,7 @@ void MainWindow::onClipLineCohenSutherland()
 
     clearLine();
     fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-    drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+    drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
 
     drawPartialLine(linePoints[0], linePoints[1], clippingWindow, QBrush(Qt::green), QBrush(Qt::gray), true);
 
@@ -188,7 +318,7 @@ void MainWindow::onClipLineLiangBarsky()
 
     clearLine();
     fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-    drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+    drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
 
     drawPartialLine(linePoints[0], linePoints[1], clippingWindow, QBrush(Qt::green), QBrush(Qt::gray), false);
 
@@ -208,30 +338,82 @@ void MainWindow::onClearAll()
     scene->update();
 }
 
+// The line's cells as row spans. Drawing, clipping and erasing the same line share one cache
+// entry, so only the first of them runs Bresenham.
+const QVector<CellSpan>& MainWindow::lineSpans(const QPoint& p1, const QPoint& p2)
+{
+    return rasterCache.lookup(RasterCache::Line, { p1, p2 }, [&](QVector<QPoint>& cells) {
+        LineKernel::bresenham(p1, p2, [&](int x, int y) { cells.append(QPoint(x, y)); });
+    }).spans;
+}
+
+// The current line's cells at the width and cap it was drawn with.
+QVector<CellSpan> MainWindow::lineStroke(const QPoint& p1, const QPoint& p2)
+{
+    if (lineWidth > 1)
+        return strokeSpans({ QPointF(p1), QPointF(p2) }, lineWidth, lineCap, false);
+    return lineSpans(p1, p2);
+}
+
 void MainWindow::bresenhamLine(const QPoint& p1, const QPoint& p2, const QBrush& brush)
 {
-    int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
-    int dx = abs(x2 - x1), dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
+    paintSpans(lineSpans(p1, p2), brush);
+}
 
-    while (true) {
-        scene->paintCell(QPoint(x1, y1), brush);
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx) { err += dx; y1 += sy; }
+void MainWindow::drawRectangle(const QRect& rect, const QBrush& brush, int thickness)
+{
+    if (thickness <= 0) return;
+
+    // a band at least half the rectangle wide leaves no hole, so the outline is a solid block
+    if (2 * thickness >= rect.width() || 2 * thickness >= rect.height()) {
+        for (int y = rect.top(); y <= rect.bottom(); ++y)
+            scene->paintSpan(y, rect.left(), rect.right(), brush);
+        return;
     }
+
+    // stroke the centre line of the band so the outer edge lands on the rectangle's border
+    const double inset = (thickness - 1) / 2.0;
+    QVector<QPointF> outline = {
+        QPointF(rect.left() + inset, rect.top() + inset),
+        QPointF(rect.right() - inset, rect.top() + inset),
+        QPointF(rect.right() - inset, rect.bottom() - inset),
+        QPointF(rect.left() + inset, rect.bottom() - inset)
+    };
+    paintSpans(strokeSpans(outline, thickness, ButtCap, true), brush);
 }
 
-void MainWindow::drawRectangle(const QRect& rect, const QBrush& brush, int thickness)
+void MainWindow::drawThickLine(const QPoint& p1, const QPoint& p2, const QBrush& brush, int thickness, LineCap cap)
+{
+    if (thickness <= 1) {
+        bresenhamLine(p1, p2, brush);
+        return;
+    }
+    paintSpans(strokeSpans({ QPointF(p1), QPointF(p2) }, thickness, cap, false), brush);
+}
+
+void MainWindow::paintSpans(const QVector<CellSpan>& spans, const QBrush& brush)
+{
+    for (const CellSpan& s : spans)
+        scene->paintSpan(s.y, s.x0, s.x1, brush);
+}
+
+// Paint the part of each span inside window with insideBrush and the rest with outsideBrush.
+// A null brush leaves its cells untouched, and a null window puts every cell outside.
+void MainWindow::paintSpans(const QVector<CellSpan>& spans, const QRect& window, const QBrush* insideBrush, const QBrush* outsideBrush)
 {
-    for (int i = 0; i < thickness; ++i) {
-        bresenhamLine(QPoint(rect.left() + i, rect.top() + i), QPoint(rect.right() - i, rect.top() + i), brush);
-        bresenhamLine(QPoint(rect.left() + i, rect.bottom() - i), QPoint(rect.right() - i, rect.bottom() - i), brush);
-        bresenhamLine(QPoint(rect.left() + i, rect.top() + i), QPoint(rect.left() + i, rect.bottom() - i), brush);
-        bresenhamLine(QPoint(rect.right() - i, rect.top() + i), QPoint(rect.right() - i, rect.bottom() - i), brush);
+    for (const CellSpan& s : spans) {
+        if (window.isNull() || s.y < window.top() || s.y > window.bottom() ||
+            s.x1 < window.left() || s.x0 > window.right()) {
+            if (outsideBrush) scene->paintSpan(s.y, s.x0, s.x1, *outsideBrush);
+            continue;
+        }
+        const int a = std::max(s.x0, window.left());
+        const int b = std::min(s.x1, window.right());
+        if (outsideBrush) {
+            if (s.x0 < a) scene->paintSpan(s.y, s.x0, a - 1, *outsideBrush);
+            if (b < s.x1) scene->paintSpan(s.y, b + 1, s.x1, *outsideBrush);
+        }
+        if (insideBrush) scene->paintSpan(s.y, a, b, *insideBrush);
     }
 }
 
@@ -242,24 +424,7 @@ bool MainWindow::isPointInsideWindow(const QPoint& p, const QRect& window)
 
 void MainWindow::drawPartialLine(const QPoint& p1, const QPoint& p2, const QRect& window, const QBrush& insideBrush, const QBrush& outsideBrush, bool useCohenSutherland)
 {
-    int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
-    int dx = abs(x2 - x1), dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-
-    while (true) {
-        QPoint cell(x1, y1);
-        if (isPointInsideWindow(cell, window))
-            scene->paintCell(cell, insideBrush);
-        else
-            scene->paintCell(cell, outsideBrush);
-
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx)  { err += dx; y1 += sy; }
-    }
+    paintSpans(lineStroke(p1, p2), window, &insideBrush, &outsideBrush);
 }
 
 
@@ -267,24 +432,9 @@ void MainWindow::clearLine()
 {
     if (linePoints.size() != 2) return;
 
-    int x1 = linePoints[0].x(), y1 = linePoints[0].y();
-    int x2 = linePoints[1].x(), y2 = linePoints[1].y();
-    int dx = abs(x2 - x1), dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-
-    while (true) {
-        QPoint cell(x1, y1);
-        bool isOnWindow = hasClippingWindow && isPointInsideWindow(cell, clippingWindow);
-        if (!isOnWindow)
-            scene->paintCell(cell, QBrush(Qt::transparent));
-
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx) { err += dx; y1 += sy; }
-    }
+    // cells on the window keep the window's colours
+    const QBrush transparent(Qt::transparent);
+    paintSpans(lineStroke(linePoints[0], linePoints[1]), hasClippingWindow ? clippingWindow : QRect(), nullptr, &transparent);
 }
 
 void MainWindow::clearWindow()
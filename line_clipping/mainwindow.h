@@ -6,7 +6,9 @@
 #include <QPoint>
 #include <QPointF>
 #include <QRect>
+#include <QVector>
 #include "gridscene.h"
+#include "rastercache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -14,6 +16,8 @@ class MainWindow;
 }
 QT_END_NAMESPACE
 
+enum LineCap { ButtCap, SquareCap };
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -41,15 +45,25 @@ private:
     QList<QPoint> originalLinePoints;
     bool isDrawingLine;
     int lineClickCount;
+    int lineWidth;      // stroke width and cap the current line was drawn with
+    LineCap lineCap;
 
     QRect clippingWindow;
     bool hasClippingWindow;
     bool isDrawingWindow;
     int windowClickCount;
     QPoint windowStart;
+    int windowBorder;
+
+    RasterCache rasterCache;
 
+    const QVector<CellSpan>& lineSpans(const QPoint& p1, const QPoint& p2);
+    QVector<CellSpan> lineStroke(const QPoint& p1, const QPoint& p2);
     void bresenhamLine(const QPoint& p1, const QPoint& p2, const QBrush& brush);
     void drawRectangle(const QRect& rect, const QBrush& brush, int thickness = 1);
+    void drawThickLine(const QPoint& p1, const QPoint& p2, const QBrush& brush, int thickness, LineCap cap = SquareCap);
+    void paintSpans(const QVector<CellSpan>& spans, const QBrush& brush);
+    void paintSpans(const QVector<CellSpan>& spans, const QRect& window, const QBrush* insideBrush, const QBrush* outsideBrush);
     void fillWindow(const QRect& rect, const QColor& color, int alpha);
     void clearLine();
     void clearWindow();
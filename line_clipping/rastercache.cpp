@@ -0,0 +1,51 @@
+#include "rastercache.h"
+#include <algorithm>
+
+QByteArray RasterCache::makeKey(Kind kind, const QVector<QPoint>& points, const QRect& clip)
+{
+    QVector<int> words;
+    words.reserve(5 + 2 * points.size());
+    words << int(kind) << clip.left() << clip.top() << clip.right() << clip.bottom();
+    for (const QPoint& p : points) words << p.x() << p.y();
+    return QByteArray(reinterpret_cast<const char*>(words.constData()), int(words.size() * sizeof(int)));
+}
+
+const RasterCache::Entry& RasterCache::lookup(Kind kind, const QVector<QPoint>& points, const QRect& clip, const Rasteriser& raster)
+{
+    const QByteArray key = makeKey(kind, points, clip);
+    if (Entry* hit = cache.object(key)) {
+        ++hits;
+        return *hit;
+    }
+    ++misses;
+
+    QVector<QPoint> cells;
+    raster(cells);
+
+    Entry* entry = new Entry;
+    entry->writes = cells.size();
+    std::sort(cells.begin(), cells.end(), [](const QPoint& a, const QPoint& b) {
+        return a.y() != b.y() ? a.y() < b.y() : a.x() < b.x();
+    });
+    for (const QPoint& c : cells) {
+        if (!entry->spans.isEmpty()) {
+            CellSpan& last = entry->spans.last();
+            if (last.y == c.y() && c.x() <= last.x1 + 1) {
+                last.x1 = std::max(last.x1, c.x());
+                continue;
+            }
+        }
+        entry->spans.append({ c.y(), c.x(), c.x() });
+    }
+    for (const CellSpan& s : entry->spans) entry->cells += s.x1 - s.x0 + 1;
+
+    // QCache deletes an entry that exceeds the whole budget instead of storing it
+    const int cost = std::max(1, int(entry->spans.size()));
+    if (cost > cache.maxCost()) {
+        uncached = *entry;
+        delete entry;
+        return uncached;
+    }
+    cache.insert(key, entry, cost);
+    return *entry;
+}
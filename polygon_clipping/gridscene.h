@@ -14,6 +14,7 @@ public:
     explicit GridScene(QObject *parent = nullptr);
 
     void paintCell(const QPoint& cell, const QBrush& brush);
+    void paintSpan(int y, int x0, int x1, const QBrush& brush);
     void clearCells();
     void setCellSize(int size) { cellSize = size; }
     int getCellSize() const { return cellSize; }
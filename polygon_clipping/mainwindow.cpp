@@ -2,7 +2,9 @@
 #include "ui_mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 #include <QMessageBox>
+#include <QStatusBar>
 #include <cmath>
 #include <algorithm>
 
@@ -15,15 +17,141 @@ static inline bool peq(const QPointF& a, const QPointF& b){
 }
 
 
+// Cell (x, y) is covered when its centre lies inside the polygon; the test is half-open
+// ([top, bottom) and [left, right)) so polygons sharing an edge never both claim a cell.
+static void scanPolygonSpans(const QVector<QPointF>& poly, QVector<CellSpan>& spans)
+{
+    const int n = poly.size();
+    if (n < 3) return;
+
+    double yMin = poly[0].y(), yMax = poly[0].y();
+    for (const QPointF& p : poly) {
+        yMin = std::min(yMin, p.y());
+        yMax = std::max(yMax, p.y());
+    }
+
+    for (int y = int(std::ceil(yMin)); y < yMax; ++y) {
+        double xl = 0.0, xr = 0.0;
+        bool hit = false;
+        for (int i = 0; i < n; ++i) {
+            const QPointF& a = poly[i];
+            const QPointF& b = poly[(i + 1) % n];
+            if ((a.y() <= y) == (b.y() <= y)) continue;
+            double x = a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+            if (!hit) { xl = xr = x; hit = true; }
+            else { xl = std::min(xl, x); xr = std::max(xr, x); }
+        }
+        int x0 = int(std::ceil(xl)), x1 = int(std::ceil(xr)) - 1;
+        if (hit && x0 <= x1) spans.append({y, x0, x1});
+    }
+}
+
+// Stroke a polyline of the given width: each segment becomes a quad whose ends are mitred
+// against its neighbours (bevelled past the mitre limit) or capped at open ends, and the
+// per-row spans of all quads are merged so the covered area is emitted once.
+static QVector<CellSpan> strokeSpans(const QVector<QPointF>& points, double width, LineCap cap, bool closed)
+{
+    QVector<CellSpan> spans;
+    if (points.isEmpty() || width <= 0.0) return spans;
+
+    QVector<QPointF> v;
+    for (const QPointF& p : points)
+        if (v.isEmpty() || p != v.last()) v.append(p);
+    if (v.size() > 1 && v.first() == v.last()) v.removeLast();
+    if (v.size() < 3) closed = false;
+
+    const double hw = width / 2.0;
+    const double miterLimit = 4.0;  // max mitre length, in half-widths
+
+    if (v.size() == 1) {
+        if (cap == SquareCap) {
+            const QPointF& c = v[0];
+            scanPolygonSpans({ {c.x() - hw, c.y() - hw}, {c.x() + hw, c.y() - hw},
+                               {c.x() + hw, c.y() + hw}, {c.x() - hw, c.y() + hw} }, spans);
+        }
+        return spans;
+    }
+
+    const int n = v.size();
+    const int segCount = closed ? n : n - 1;
+    QVector<QPointF> dir(segCount), nrm(segCount);
+    for (int i = 0; i < segCount; ++i) {
+        QPointF d = v[(i + 1) % n] - v[i];
+        double len = std::sqrt(d.x() * d.x() + d.y() * d.y());
+        dir[i] = d / len;
+        nrm[i] = QPointF(-dir[i].y(), dir[i].x());
+    }
+
+    // Offset of the join between segments a and b (a entering, b leaving the shared vertex),
+    // or false when the mitre would exceed the limit and a bevel is needed instead.
+    auto miterOffset = [&](int a, int b, QPointF& offset) {
+        QPointF m = nrm[a] + nrm[b];
+        double len2 = m.x() * m.x() + m.y() * m.y();
+        if (len2 * miterLimit * miterLimit < 4.0) return false;
+        offset = m * (2.0 * hw / len2);
+        return true;
+    };
+
+    for (int i = 0; i < segCount; ++i) {
+        const QPointF& a = v[i];
+        const QPointF& b = v[(i + 1) % n];
+        QPointF aL = a + nrm[i] * hw, aR = a - nrm[i] * hw;
+        QPointF bL = b + nrm[i] * hw, bR = b - nrm[i] * hw;
+        QPointF offset;
+
+        if (closed || i > 0) {
+            int prev = (i + segCount - 1) % segCount;
+            if (miterOffset(prev, i, offset)) {
+                aL = a + offset;
+                aR = a - offset;
+            } else {
+                scanPolygonSpans({ a, a + nrm[prev] * hw, aL }, spans);
+                scanPolygonSpans({ a, a - nrm[prev] * hw, aR }, spans);
+            }
+        } else if (cap == SquareCap) {
+            aL = aL - dir[i] * hw;
+            aR = aR - dir[i] * hw;
+        }
+
+        if (closed || i < segCount - 1) {
+            int next = (i + 1) % segCount;
+            if (miterOffset(i, next, offset)) {
+                bL = b + offset;
+                bR = b - offset;
+            }
+        } else if (cap == SquareCap) {
+            bL = bL + dir[i] * hw;
+            bR = bR + dir[i] * hw;
+        }
+
+        scanPolygonSpans({ aL, bL, bR, aR }, spans);
+    }
+
+    std::sort(spans.begin(), spans.end(), [](const CellSpan& l, const CellSpan& r) {
+        return l.y < r.y || (l.y == r.y && l.x0 < r.x0);
+    });
+    QVector<CellSpan> merged;
+    for (const CellSpan& s : spans) {
+        if (!merged.isEmpty() && merged.last().y == s.y && s.x0 <= merged.last().x1 + 1)
+            merged.last().x1 = std::max(merged.last().x1, s.x1);
+        else
+            merged.append(s);
+    }
+    return merged;
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new GridScene(this))
     , hasPolygon(false)
     , isSelectingVertices(false)
+    , outlineWidth(1)
+    , outlineCap(SquareCap)
     , hasClippingWindow(false)
     , isDrawingWindow(false)
     , windowClickCount(0)
+    , windowBorder(1)
 {
     ui->setupUi(this);
 
@@ -55,8 +183,15 @@ MainWindow::~MainWindow()
 void MainWindow::onCellClicked(const QPoint& cell)
 {
     if (isSelectingVertices) {
-        polygonVertices.append(cell);
-        scene->paintCell(cell, QBrush(Qt::blue));
+        if (outlineWidth > 1) {
+            // restroke the open path so the cap at the previous end turns into a join
+            clearPolygon();
+            polygonVertices.append(cell);
+            paintSpans(outlineStroke(polygonVertices, false), QBrush(Qt::blue));
+        } else {
+            polygonVertices.append(cell);
+            scene->paintCell(cell, QBrush(Qt::blue));
+        }
         scene->update();
     }
     else if (isDrawingWindow) {
@@ -71,8 +206,9 @@ void MainWindow::onCellClicked(const QPoint& cell)
             int xMax = std::max(windowStart.x(), cell.x());
             int yMax = std::max(windowStart.y(), cell.y());
             clippingWindow = QRect(QPoint(xMin, yMin), QPoint(xMax, yMax));
+            windowBorder = ui->strokeWidth->value();
             fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-            drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+            drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
             if (hasPolygon) drawPolygonOutline(polygonVertices, QBrush(Qt::blue));
             hasClippingWindow = true;
             isDrawingWindow = false;
@@ -97,15 +233,18 @@ void MainWindow::onDrawPolygon()
         }
 
         originalPolygonVertices = polygonVertices;
+        if (outlineWidth > 1) clearPolygon();  // drop the open path's end caps
+        isSelectingVertices = false;
         drawPolygonOutline(polygonVertices, QBrush(Qt::blue), true);
         hasPolygon = true;
-        isSelectingVertices = false;
         scene->update();
     }
     else {
         clearPolygon();
         polygonVertices.clear();
         originalPolygonVertices.clear();
+        outlineWidth = ui->strokeWidth->value();
+        outlineCap = static_cast<LineCap>(ui->lineCap->currentIndex());
         isSelectingVertices = true;
         hasPolygon = false;
         QMessageBox::information(this, "Draw Polygon", "Click on the grid to select vertices. Click 'Draw Polygon' again to finish.");
@@ -183,7 +322,7 @@ void MainWindow::onClipPolygonSutherHodge()
     clearPolygon();
     drawPolygonOutline(original, QBrush(Qt::gray), true);
     fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-    drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+    drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
 
     if (clippedPolygon.size() >= 2) {
         QList<QPoint> clippedInt;
@@ -312,7 +451,7 @@ void MainWindow::weilerAthertonPolygonClip()
     clearPolygon();
     if (!original.isEmpty()) drawPolygonOutline(original, QBrush(Qt::lightGray), /*collect=*/true);
     fillWindow(clippingWindow, QColor(173, 216, 230), 120);
-    drawRectangle(clippingWindow, QBrush(Qt::red), 1);
+    drawRectangle(clippingWindow, QBrush(Qt::red), windowBorder);
 
 
     if (subjectInserts.isEmpty()) {
@@ -322,7 +461,7 @@ void MainWindow::weilerAthertonPolygonClip()
             QPointF center((clippingWindow.left()+clippingWindow.right())/2.0,
                            (clippingWindow.top() +clippingWindow.bottom())/2.0);
             if (!origPoly.isEmpty() && pointInPolygon(origPoly, center)) {
-                drawRectangle(clippingWindow, QBrush(Qt::green));
+                drawRectangle(clippingWindow, QBrush(Qt::green), windowBorder);
             }
         }
         scene->update();
@@ -397,22 +536,20 @@ void MainWindow::onClearAll()
 
 void MainWindow::bresenhamLine(const QPoint& p1, const QPoint& p2, const QBrush& brush, bool collect)
 {
-    int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
-    int dx = abs(x2 - x1), dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-
-    while (true) {
-        QPoint q(x1, y1);
-        scene->paintCell(q, brush);
-        if (collect) polygonPixels.insert(q);
+    const RasterCache::Entry& line = rasterCache.lookup(RasterCache::Line, { p1, p2 }, [&](QVector<QPoint>& cells) {
+        LineKernel::bresenham(p1, p2, [&](int x, int y) { cells.append(QPoint(x, y)); });
+    });
+    paintSpans(line.spans, brush, collect);
+}
 
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx) { err += dx; y1 += sy; }
-    }
+// The closed outline's cells as row spans. Drawing, re-highlighting and erasing an unchanged
+// polygon share one cache entry, so only the first of them rasterises it.
+const RasterCache::Entry& MainWindow::outlineRaster(const QList<QPoint>& vertices)
+{
+    const QVector<QPoint> key(vertices.begin(), vertices.end());
+    return rasterCache.lookup(RasterCache::ClosedPolyline, key, [&](QVector<QPoint>& cells) {
+        LineKernel::polyline(key, true, [&](int x, int y) { cells.append(QPoint(x, y)); });
+    });
 }
 
 
@@ -420,15 +557,33 @@ void MainWindow::drawPolygonOutline(const QList<QPoint>& vertices, const QBrush&
 {
     if (vertices.size() < 2) return;
 
-    for (const QPoint& v : vertices) {
-        scene->paintCell(v, brush);
-        if (collect) polygonPixels.insert(v);
+    if (outlineWidth > 1) {
+        paintSpans(outlineStroke(vertices, true), brush, collect);
+        return;
     }
 
-    for (int i = 0; i < vertices.size(); i++) {
-        int nextIndex = (i + 1) % vertices.size();
-        bresenhamLine(vertices[i], vertices[nextIndex], brush, collect);
-    }
+    // every vertex is an edge endpoint, so walking the closed polyline covers them too
+    const RasterCache::Entry& outline = outlineRaster(vertices);
+    paintSpans(outline.spans, brush, collect);
+    showOverdraw(outline.writes, outline.cells, vertices.size() + LineKernel::segmentWrites(vertices, true));
+}
+
+void MainWindow::showOverdraw(qint64 writes, qint64 cells, qint64 perEdgeWrites)
+{
+    if (cells == 0) return;
+    statusBar()->showMessage(QString("Outline: %1 cells, %2 writes (%3% overdraw); per-edge drawing would write %4")
+                                 .arg(cells).arg(writes)
+                                 .arg(100.0 * (writes - cells) / cells, 0, 'f', 1)
+                                 .arg(perEdgeWrites));
+}
+
+// The vertices stroked at the polygon's width; a lone vertex gets a square dot so the first
+// click shows with either cap.
+QVector<CellSpan> MainWindow::outlineStroke(const QList<QPoint>& vertices, bool closed) const
+{
+    QVector<QPointF> path;
+    for (const QPoint& v : vertices) path.append(QPointF(v));
+    return strokeSpans(path, outlineWidth, vertices.size() == 1 ? SquareCap : outlineCap, closed);
 }
 
 
@@ -442,11 +597,52 @@ void MainWindow::drawRectangle(const QRect& rect, const QBrush& brush)
 
 void MainWindow::drawRectangle(const QRect& rect, const QBrush& brush, int thickness)
 {
-    for (int i = 0; i < thickness; ++i) {
-        bresenhamLine(QPoint(rect.left() + i, rect.top() + i), QPoint(rect.right() - i, rect.top() + i), brush);
-        bresenhamLine(QPoint(rect.left() + i, rect.bottom() - i), QPoint(rect.right() - i, rect.bottom() - i), brush);
-        bresenhamLine(QPoint(rect.left() + i, rect.top() + i), QPoint(rect.left() + i, rect.bottom() - i), brush);
-        bresenhamLine(QPoint(rect.right() - i, rect.top() + i), QPoint(rect.right() - i, rect.bottom() - i), brush);
+    if (thickness <= 0) return;
+
+    // a band at least half the rectangle wide leaves no hole, so the outline is a solid block
+    if (2 * thickness >= rect.width() || 2 * thickness >= rect.height()) {
+        for (int y = rect.top(); y <= rect.bottom(); ++y)
+            scene->paintSpan(y, rect.left(), rect.right(), brush);
+        return;
+    }
+
+    // stroke the centre line of the band so the outer edge lands on the rectangle's border
+    const double inset = (thickness - 1) / 2.0;
+    QVector<QPointF> outline = {
+        QPointF(rect.left() + inset, rect.top() + inset),
+        QPointF(rect.right() - inset, rect.top() + inset),
+        QPointF(rect.right() - inset, rect.bottom() - inset),
+        QPointF(rect.left() + inset, rect.bottom() - inset)
+    };
+    paintSpans(strokeSpans(outline, thickness, ButtCap, true), brush);
+}
+
+void MainWindow::paintSpans(const QVector<CellSpan>& spans, const QBrush& brush, bool collect)
+{
+    for (const CellSpan& s : spans) {
+        scene->paintSpan(s.y, s.x0, s.x1, brush);
+        if (collect)
+            for (int x = s.x0; x <= s.x1; ++x) polygonPixels.insert(QPoint(x, s.y));
+    }
+}
+
+// Paint the part of each span inside window with insideBrush and the rest with outsideBrush.
+// A null brush leaves its cells untouched, and a null window puts every cell outside.
+void MainWindow::paintSpans(const QVector<CellSpan>& spans, const QRect& window, const QBrush* insideBrush, const QBrush* outsideBrush)
+{
+    for (const CellSpan& s : spans) {
+        if (window.isNull() || s.y < window.top() || s.y > window.bottom() ||
+            s.x1 < window.left() || s.x0 > window.right()) {
+            if (outsideBrush) scene->paintSpan(s.y, s.x0, s.x1, *outsideBrush);
+            continue;
+        }
+        const int a = std::max(s.x0, window.left());
+        const int b = std::min(s.x1, window.right());
+        if (outsideBrush) {
+            if (s.x0 < a) scene->paintSpan(s.y, s.x0, a - 1, *outsideBrush);
+            if (b < s.x1) scene->paintSpan(s.y, b + 1, s.x1, *outsideBrush);
+        }
+        if (insideBrush) scene->paintSpan(s.y, a, b, *insideBrush);
     }
 }
 
@@ -466,49 +662,15 @@ void MainWindow::fillWindow(const QRect& rect, const QColor& color, int alpha)
 
 void MainWindow::clearPolygon()
 {
-    if (polygonVertices.size() < 2) return;
+    if (outlineWidth <= 1 && polygonVertices.size() < 2) return;
     polygonPixels.clear();
 
-    for (const QPoint& v : polygonVertices) {
-        bool skip = false;
-        if (hasClippingWindow) {
-            if (clippingWindow.contains(v)) skip = true;
-            bool onLeft = (v.x() == clippingWindow.left() && v.y() >= clippingWindow.top() && v.y() <= clippingWindow.bottom());
-            bool onRight = (v.x() == clippingWindow.right() && v.y() >= clippingWindow.top() && v.y() <= clippingWindow.bottom());
-            bool onTop = (v.y() == clippingWindow.top() && v.x() >= clippingWindow.left() && v.x() <= clippingWindow.right());
-            bool onBottom = (v.y() == clippingWindow.bottom() && v.x() >= clippingWindow.left() && v.x() <= clippingWindow.right());
-            if (onLeft || onRight || onTop || onBottom) skip = true;
-        }
-        if (!skip) scene->paintCell(v, QBrush(Qt::transparent));
-    }
-
-    for (int i = 0; i < polygonVertices.size(); i++) {
-        int nextIndex = (i + 1) % polygonVertices.size();
-        QPoint p1 = polygonVertices[i];
-        QPoint p2 = polygonVertices[nextIndex];
-        int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
-        int dx = std::abs(x2 - x1), dy = std::abs(y2 - y1);
-        int sx = (x1 < x2) ? 1 : -1;
-        int sy = (y1 < y2) ? 1 : -1;
-        int err = dx - dy;
-        while (true) {
-            bool skip = false;
-            if (hasClippingWindow) {
-                if (x1 >= clippingWindow.left() && x1 <= clippingWindow.right() &&
-                    y1 >= clippingWindow.top()  && y1 <= clippingWindow.bottom()) skip = true;
-                bool onLeft = (x1 == clippingWindow.left() && y1 >= clippingWindow.top() && y1 <= clippingWindow.bottom());
-                bool onRight = (x1 == clippingWindow.right() && y1 >= clippingWindow.top() && y1 <= clippingWindow.bottom());
-                bool onTop = (y1 == clippingWindow.top() && x1 >= clippingWindow.left() && x1 <= clippingWindow.right());
-                bool onBottom = (y1 == clippingWindow.bottom() && x1 >= clippingWindow.left() && x1 <= clippingWindow.right());
-                if (onLeft || onRight || onTop || onBottom) skip = true;
-            }
-            if (!skip) scene->paintCell(QPoint(x1, y1), QBrush(Qt::transparent));
-            if (x1 == x2 && y1 == y2) break;
-            int e2 = 2 * err;
-            if (e2 > -dy) { err -= dy; x1 += sx; }
-            if (e2 < dx) { err += dx; y1 += sy; }
-        }
-    }
+    // cells on or inside the clipping window keep the window's colours; a thick polygon still
+    // being entered is an open path
+    const QBrush transparent(Qt::transparent);
+    const QVector<CellSpan> spans = outlineWidth > 1 ? outlineStroke(polygonVertices, !isSelectingVertices)
+                                                     : outlineRaster(polygonVertices).spans;
+    paintSpans(spans, hasClippingWindow ? clippingWindow : QRect(), nullptr, &transparent);
 }
 
 
@@ -10,6 +10,7 @@
 #include <QMap>
 #include <cmath>
 #include "gridscene.h"
+#include "rastercache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -17,6 +18,8 @@ class MainWindow;
 }
 QT_END_NAMESPACE
 
+enum LineCap { ButtCap, SquareCap };
+
 struct VertexData {
     QPointF pos;
     bool isIntersection = false;
@@ -52,17 +55,27 @@ private:
     QList<QPoint> originalPolygonVertices;
     bool hasPolygon;
     bool isSelectingVertices;
+    int outlineWidth;       // stroke width and cap the current polygon was drawn with
+    LineCap outlineCap;
 
     QRect clippingWindow;
     bool hasClippingWindow;
     bool isDrawingWindow;
     int windowClickCount;
     QPoint windowStart;
+    int windowBorder;
+
+    RasterCache rasterCache;
 
+    const RasterCache::Entry& outlineRaster(const QList<QPoint>& vertices);
     void bresenhamLine(const QPoint& p1, const QPoint& p2, const QBrush& brush, bool collect = false);
     void drawPolygonOutline(const QList<QPoint>& vertices, const QBrush& brush, bool collect = false);
+    void showOverdraw(qint64 writes, qint64 cells, qint64 perEdgeWrites);
+    QVector<CellSpan> outlineStroke(const QList<QPoint>& vertices, bool closed) const;
     void drawRectangle(const QRect& rect, const QBrush& brush);
     void drawRectangle(const QRect& rect, const QBrush& brush, int thickness);
+    void paintSpans(const QVector<CellSpan>& spans, const QBrush& brush, bool collect = false);
+    void paintSpans(const QVector<CellSpan>& spans, const QRect& window, const QBrush* insideBrush, const QBrush* outsideBrush);
     void clearPolygon();
     void clearWindow();
     void fillWindow(const QRect& rect, const QColor& color, int alpha);
@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -134,31 +135,41 @@ void MainWindow::onStepsChanged(int v) {
 
 void MainWindow::stepAnimation() {
     if (animIndex >= bezierPts.size()) { animTimer.stop(); return; }
-    bresenhamLine(bezierPts[animIndex-1], bezierPts[animIndex], curveBrush);
+    // the previous chord already painted this chord's first cell
+    const QPoint& a = bezierPts[animIndex-1];
+    const QPoint& b = bezierPts[animIndex];
+    const int steps = qMax(qAbs(b.x() - a.x()), qAbs(b.y() - a.y()));
+    LineKernel::bresenhamRange(a, b, animIndex > 1 ? 1 : 0, steps, [&](int x, int y) {
+        scene->paintCell(QPoint(x, y), curveBrush);
+    });
     animIndex++;
 }
 
 void MainWindow::repaintAll() {
     scene->clearCells();
     for (const auto& p : controlPts) scene->paintCell(p, ctrlBrush);
-    if (chkShowPoly->isChecked() && controlPts.size() >= 2) {
-        for (int i = 0; i+1 < controlPts.size(); ++i) bresenhamLine(controlPts[i], controlPts[i+1], polyBrush);
-    }
-    if (!bezierPts.isEmpty()) {
-        for (int i = 1; i < bezierPts.size(); ++i) bresenhamLine(bezierPts[i-1], bezierPts[i], curveBrush);
-    }
+    if (chkShowPoly->isChecked() && controlPts.size() >= 2) drawPolyline(controlPts, polyBrush);
+    if (bezierPts.size() >= 2) drawPolyline(bezierPts, curveBrush);
 }
 
 void MainWindow::drawControlPolygon() {
-    if (controlPts.size() >= 2)
-        for (int i = 0; i+1 < controlPts.size(); ++i) bresenhamLine(controlPts[i], controlPts[i+1], polyBrush);
+    if (controlPts.size() >= 2) drawPolyline(controlPts, polyBrush);
 }
 
 void MainWindow::drawBezierImmediate() {
     scene->clearCells();
     for (const auto& p : controlPts) scene->paintCell(p, ctrlBrush);
     if (chkShowPoly->isChecked()) drawControlPolygon();
-    for (int i = 1; i < bezierPts.size(); ++i) bresenhamLine(bezierPts[i-1], bezierPts[i], curveBrush);
+    if (bezierPts.size() < 2) return;
+
+    QSet<QPoint> cells;
+    const qint64 writes = drawPolyline(bezierPts, curveBrush, &cells);
+    const qint64 perChord = LineKernel::segmentWrites(bezierPts, false);
+    setStatus(QString("Curve: %1 cells, %2 writes (%3% overdraw); per-chord drawing would write %4 (%5%)")
+                  .arg(cells.size()).arg(writes)
+                  .arg(100.0 * (writes - cells.size()) / cells.size(), 0, 'f', 1)
+                  .arg(perChord)
+                  .arg(100.0 * (perChord - cells.size()) / cells.size(), 0, 'f', 1));
 }
 
 void MainWindow::buildBezierSamplePoints() {
@@ -184,17 +195,12 @@ void MainWindow::buildBezierSamplePoints() {
     }
 }
 
-void MainWindow::bresenhamLine(const QPoint& a, const QPoint& b, const QBrush& brush) {
-    int x1 = a.x(), y1 = a.y(), x2 = b.x(), y2 = b.y();
-    int dx = qAbs(x2 - x1), dy = qAbs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-    while (true) {
-        scene->paintCell(QPoint(x1, y1), brush);
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx)  { err += dx; y1 += sy; }
-    }
+// Draws the chords through pts without repainting shared endpoints or collinear runs;
+// returns the number of cell writes, and fills cells with the distinct cells when given.
+qint64 MainWindow::drawPolyline(const QVector<QPoint>& pts, const QBrush& brush, QSet<QPoint>* cells) {
+    return LineKernel::polyline(pts, false, [&](int x, int y) {
+        QPoint q(x, y);
+        scene->paintCell(q, brush);
+        if (cells) cells->insert(q);
+    });
 }
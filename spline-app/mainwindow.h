@@ -4,6 +4,7 @@
 #include <QVector>
 #include <QBrush>
 #include <QTimer>
+#include <QSet>
 
 class GridScene;
 class GridView;
@@ -34,7 +35,7 @@ private:
     void drawControlPolygon();
     void drawBezierImmediate();
     void buildBezierSamplePoints();
-    void bresenhamLine(const QPoint& a, const QPoint& b, const QBrush& brush);
+    qint64 drawPolyline(const QVector<QPoint>& pts, const QBrush& brush, QSet<QPoint>* cells = nullptr);
 
     GridScene* scene = nullptr;
     GridView*  view  = nullptr;
@@ -17,6 +17,7 @@ SOURCES += \
 HEADERS += \
     gridscene.h \
     gridview.h \
+    linekernel.h \
     mainwindow.h
 
 FORMS += \
@@ -6,6 +6,7 @@
 #include <QPoint>
 #include <QPointF>
 #include "gridscene.h"
+#include "rastercache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -43,7 +44,7 @@ private slots:
 
 private:
     void drawLines();
-    void bresenhamCells(const QPoint& p1, const QPoint& p2);
+    void bresenhamCells(const QPoint& p1, const QPoint& p2, QVector<QPoint>& cells);
 
     // Helpers
     QList<QPoint> roundedCells(const QList<QPointF>& floatCells) const;
@@ -58,6 +59,7 @@ private:
 
     Ui::MainWindow *ui;
     GridScene *scene;
+    RasterCache rasterCache;
 
     QList<QPoint> originalCells;
     QList<QPointF> originalCellsF;
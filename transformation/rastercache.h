@@ -0,0 +1,57 @@
+#ifndef RASTERCACHE_H
+#define RASTERCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+#include <functional>
+
+struct CellSpan {
+    int y;
+    int x0;
+    int x1;
+};
+
+// Small LRU cache of rasterised primitives, keyed by primitive kind and parameters. Each
+// entry stores the primitive's cells as sorted, merged row spans. Erasing, restoring or
+// re-highlighting a shape that has not changed replays its spans instead of running the
+// rasteriser again. Entries are costed by span count.
+class RasterCache {
+public:
+    enum Kind { Line, ClosedPolyline, ClippedOutline };
+
+    struct Entry {
+        QVector<CellSpan> spans;    // disjoint, ordered by row and then column
+        qint64 writes = 0;          // cells the rasteriser emitted, repeats included
+        qint64 cells = 0;           // distinct cells, i.e. the total length of the spans
+    };
+
+    // Receives the cell list to append to on a miss.
+    using Rasteriser = std::function<void(QVector<QPoint>&)>;
+
+    explicit RasterCache(int maxSpans = 1 << 15) : cache(maxSpans) {}
+
+    // The entry for the key, rasterising on a miss. The reference stays valid until the next
+    // lookup, which may evict it.
+    const Entry& lookup(Kind kind, const QVector<QPoint>& points, const QRect& clip, const Rasteriser& raster);
+    const Entry& lookup(Kind kind, const QVector<QPoint>& points, const Rasteriser& raster)
+    {
+        return lookup(kind, points, QRect(), raster);
+    }
+
+    void clear() { cache.clear(); }
+    int hitCount() const { return hits; }
+    int missCount() const { return misses; }
+
+private:
+    static QByteArray makeKey(Kind kind, const QVector<QPoint>& points, const QRect& clip);
+
+    QCache<QByteArray, Entry> cache;
+    Entry uncached;     // holds a result too large to cache
+    int hits = 0;
+    int misses = 0;
+};
+
+#endif // RASTERCACHE_H
@@ -18,6 +18,17 @@ void GridScene::paintCell(const QPoint& cell, const QBrush& brush) {
     }
 }
 
+void GridScene::paintSpan(int y, int x0, int x1, const QBrush& brush) {
+    for (int x = x0; x <= x1; ++x)
+        paintCell(QPoint(x, y), brush);
+}
+
+QRect GridScene::cellBounds() const {
+    const QRectF r = sceneRect();
+    return QRect(QPoint(qFloor(r.left() / cellSize), qFloor(r.top() / cellSize)),
+                 QPoint(qCeil(r.right() / cellSize) - 1, qCeil(r.bottom() / cellSize) - 1));
+}
+
 void GridScene::clearCells() {
     for (auto *item : cellItems) removeItem(item);
     qDeleteAll(cellItems);
@@ -5,6 +5,7 @@
 #include <QMap>
 #include <QPoint>
 #include <QBrush>
+#include <QRect>
 #include <QGraphicsRectItem>
 
 class GridScene : public QGraphicsScene {
@@ -14,9 +15,11 @@ public:
     explicit GridScene(QObject *parent = nullptr);
 
     void paintCell(const QPoint& cell, const QBrush& brush);
+    void paintSpan(int y, int x0, int x1, const QBrush& brush);
     void clearCells();
     void setCellSize(int size) { cellSize = size; }
     int getCellSize() const { return cellSize; }
+    QRect cellBounds() const;
 
 signals:
     void cellClicked(const QPoint& cell);
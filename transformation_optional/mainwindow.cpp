@@ -2,9 +2,35 @@
 #include "ui_mainwindow.h"
 #include "gridscene.h"
 #include "gridview.h"
+#include "linekernel.h"
 #include <QMouseEvent>
 #include <QMessageBox>
 #include <cmath>
+#include <algorithm>
+
+// Liang-Barsky against an axis-aligned box, returning the parameter range [t0, t1] of the
+// segment p1 -> p2 that lies inside it instead of the clipped endpoints.
+static bool liangBarskyRange(const QPointF& p1, const QPointF& p2, double xmin, double xmax,
+                             double ymin, double ymax, double& t0, double& t1)
+{
+    double dx = p2.x() - p1.x(), dy = p2.y() - p1.y();
+    double p[4] = {-dx, dx, -dy, dy};
+    double q[4] = {p1.x() - xmin, xmax - p1.x(), p1.y() - ymin, ymax - p1.y()};
+    t0 = 0.0;
+    t1 = 1.0;
+
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0) {
+            if (q[i] < 0) return false;
+            continue;
+        }
+        double t = q[i] / p[i];
+        if (p[i] < 0) t0 = std::max(t0, t);
+        else t1 = std::min(t1, t);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -95,15 +121,22 @@ QList<QPoint> MainWindow::roundedCells(const QList<QPointF>& floatCells) const {
 
 void MainWindow::redrawFromFloatCells() {
     scene->clearCells();
-    QList<QPoint> pts = roundedCells(currentCellsF);
-    // paint vertices
-    for (const QPoint &p : pts) scene->paintCell(p, QBrush(Qt::blue));
-    // draw outline
-    if (pts.size() >= 2) {
-        for (int i = 0; i < pts.size() - 1; ++i)
-            bresenhamCells(pts[i], pts[i+1]);
-        bresenhamCells(pts.last(), pts.first());
-    }
+    const QList<QPoint> pts = roundedCells(currentCellsF);
+    const QRect bounds = scene->cellBounds();
+
+    // Restoring or redrawing an unchanged shape replays the cached spans. Vertices and outline
+    // cells that land outside the scene can never be seen, so they are not kept.
+    const QVector<QPoint> key(pts.begin(), pts.end());
+    const RasterCache::Entry& outline = rasterCache.lookup(RasterCache::ClippedOutline, key, bounds, [&](QVector<QPoint>& cells) {
+        for (const QPoint &p : pts)
+            if (bounds.contains(p)) cells.append(p);
+        if (pts.size() >= 2) {
+            for (int i = 0; i < pts.size() - 1; ++i) bresenhamCells(pts[i], pts[i+1], cells);
+            bresenhamCells(pts.last(), pts.first(), cells);
+        }
+    });
+    for (const CellSpan &s : outline.spans)
+        scene->paintSpan(s.y, s.x0, s.x1, QBrush(Qt::blue));
     scene->update();
 }
 
@@ -122,21 +155,27 @@ void MainWindow::drawLines()
     redrawFromFloatCells();
 }
 
-void MainWindow::bresenhamCells(const QPoint& p1, const QPoint& p2)
+void MainWindow::bresenhamCells(const QPoint& p1, const QPoint& p2, QVector<QPoint>& cells)
 {
-    int x1 = p1.x(), y1 = p1.y(), x2 = p2.x(), y2 = p2.y();
-    int dx = abs(x2 - x1), dy = abs(y2 - y1);
-    int sx = (x1 < x2) ? 1 : -1;
-    int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
-
-    while (true) {
-        scene->paintCell(QPoint(x1, y1), QBrush(Qt::blue));
-        if (x1 == x2 && y1 == y2) break;
-        int e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x1 += sx; }
-        if (e2 < dx) { err += dx; y1 += sy; }
-    }
+    const QRect bounds = scene->cellBounds();
+    const qint64 dx = std::abs(qint64(p2.x()) - p1.x()), dy = std::abs(qint64(p2.y()) - p1.y());
+    const qint64 steps = std::max(dx, dy);
+
+    // Only step the stretch of the line that can land on the grid. The ideal segment is clipped
+    // against the bounds grown by one cell, and one step of slack at each end covers the
+    // distance between the ideal line and the cells Bresenham picks.
+    double t0, t1;
+    if (!liangBarskyRange(QPointF(p1), QPointF(p2), bounds.left() - 1, bounds.right() + 1,
+                          bounds.top() - 1, bounds.bottom() + 1, t0, t1))
+        return;
+    const qint64 first = std::max<qint64>(0, qint64(std::floor(t0 * steps)) - 1);
+    const qint64 last = std::min<qint64>(steps, qint64(std::ceil(t1 * steps)) + 1);
+
+    // The kernel jumps straight to step `first`, so the cells match those of the unclipped loop.
+    LineKernel::bresenhamRange(p1, p2, first, last, [&](int x, int y) {
+        if (x >= bounds.left() && x <= bounds.right() && y >= bounds.top() && y <= bounds.bottom())
+            cells.append(QPoint(x, y));
+    });
 }
 
 void MainWindow::restoreOriginal()
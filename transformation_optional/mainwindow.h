@@ -7,6 +7,7 @@
 #include <QPointF>
 #include <QVector>
 #include "gridscene.h"
+#include "rastercache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -33,7 +34,7 @@ private slots:
 
 private:
     void drawLines();
-    void bresenhamCells(const QPoint& p1, const QPoint& p2);
+    void bresenhamCells(const QPoint& p1, const QPoint& p2, QVector<QPoint>& cells);
 
     // Helpers
     QList<QPoint> roundedCells(const QList<QPointF>& floatCells) const;
@@ -55,6 +56,7 @@ private:
 
     Ui::MainWindow *ui;
     GridScene *scene;
+    RasterCache rasterCache;
 
     // Store both integer cell coordinates and floating coords for transforms
     QList<QPoint> originalCells;
@@ -12,12 +12,15 @@ SOURCES += \
     gridscene.cpp \
     gridview.cpp \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    rastercache.cpp
 
 HEADERS += \
     gridscene.h \
     gridview.h \
-    mainwindow.h
+    linekernel.h \
+    mainwindow.h \
+    rastercache.h
 
 FORMS += \
     mainwindow.ui